@@ -0,0 +1,30 @@
+//
+//  AllocationCounter.cpp
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> sAllocationCount(0);
+
+void* operator new(size_t size) {
+    sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+uint64_t getAllocationCount() {
+    return sAllocationCount.load(std::memory_order_relaxed);
+}
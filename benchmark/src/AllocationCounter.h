@@ -0,0 +1,15 @@
+//
+//  AllocationCounter.h
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+
+// every allocation in the process is counted, lemmas, host and benchmark alike. Linking AllocationCounter.cpp replaces
+//  the global operator new
+uint64_t getAllocationCount();
@@ -0,0 +1,142 @@
+//
+//  DispatchBenchmark.cpp
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "AllocationCounter.h"
+#include "Cinder-NoamProtocol.h"
+#include "boost/format.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace Cinder::Noam;
+
+static const size_t sEvents = 1000 * 1000;
+// NB - keeps the lookups from being optimized away
+static volatile Symbol sFound;
+
+// hands received events straight to the lemma, as a session's frame reader would once a frame is parsed
+class DirectTransport : public Transport {
+public:
+    void open(const std::string&, const std::vector<std::string>&, boost::asio::io_service&, const EventHandler& eventHandler) override { mEventHandler = eventHandler; }
+    void close() override { mEventHandler = nullptr; }
+    bool isOpen() const override { return static_cast<bool>(mEventHandler); }
+    void send(const boost::string_ref&, const EventValue&) override {}
+
+    inline void receive(const boost::string_ref& eventName, const EventValue& eventValue) { mEventHandler(eventName, eventValue); }
+
+private:
+    EventHandler mEventHandler;
+};
+
+static void report(const std::string& name, double elapsed, uint64_t allocations, size_t count) {
+    std::cout << str(boost::format("%-28s %7.1f ns/event  %5.2f allocations/event") % name % (elapsed * 1.0e9 / count) % (static_cast<double>(allocations) / count)) << std::endl;
+}
+
+// lookups alone, names resolved the way a received frame's are
+static void measureLookups(size_t nameCount, std::atomic<bool>* interning) {
+    SymbolTable table;
+    std::vector<std::string> names;
+    for (size_t idx = 0; idx < nameCount; idx++) {
+        names.push_back("BenchEvent" + std::to_string(idx));
+        table.intern(names.back());
+    }
+    std::vector<std::string> unheard;
+    for (size_t idx = 0; idx < nameCount; idx++) {
+        unheard.push_back("UnheardEvent" + std::to_string(idx));
+    }
+
+    // NB - another thread keeps the table growing, lookups must neither lock nor slow down
+    std::thread writer;
+    if (interning) {
+        *interning = true;
+        writer = std::thread([&table, interning]() {
+            for (size_t idx = 0; *interning; idx++) {
+                table.intern("Interned" + std::to_string(idx));
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        });
+    }
+
+    for (const std::vector<std::string>* lookups : {&names, &unheard}) {
+        Symbol found = 0;
+        uint64_t allocationStartCount = getAllocationCount();
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        for (size_t idx = 0; idx < sEvents; idx++) {
+            const std::string& name = (*lookups)[idx % lookups->size()];
+            found += table.find(boost::string_ref(name.data(), name.size()));
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        uint64_t allocations = getAllocationCount() - allocationStartCount;
+        sFound = found;
+        report(str(boost::format("find %s %5u names%s") % (lookups == &names ? "hit " : "miss") % nameCount % (interning ? " +intern" : "")), elapsed, allocations, sEvents);
+    }
+
+    if (interning) {
+        *interning = false;
+        writer.join();
+    }
+}
+
+// received events through the lemma to their handlers, dispatched right away or queued for poll() when threaded
+static void measureDispatch(size_t nameCount, bool threaded) {
+    boost::asio::io_service io;
+    Lemma::Format format = Lemma::Format().ioService(io).eventQueueCapacity(4096);
+    if (threaded) {
+        format.threaded();
+    }
+    LemmaRef lemma = Lemma::create("cinder-noamprotocol_benchmark_dispatch", "lemma_benchmark", format);
+
+    std::vector<std::string> names;
+    size_t handled = 0;
+    for (size_t idx = 0; idx < nameCount; idx++) {
+        names.push_back("BenchEvent" + std::to_string(idx));
+        lemma->connectMessageEventHandler(names.back(), [&](const std::string&, const EventValue&) {
+            handled++;
+        });
+    }
+    std::shared_ptr<DirectTransport> transport = std::make_shared<DirectTransport>();
+    lemma->begin(transport);
+    io.poll();
+
+    EventValue value = EventValue::makeInt(42, "42");
+    // NB - warm up the queue's slots and the lemma's buffers
+    for (size_t idx = 0; idx < 4096; idx++) {
+        transport->receive(names[idx % names.size()], value);
+        lemma->poll();
+    }
+
+    handled = 0;
+    uint64_t allocationStartCount = getAllocationCount();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (size_t idx = 0; idx < sEvents; idx++) {
+        const std::string& name = names[idx % names.size()];
+        transport->receive(boost::string_ref(name.data(), name.size()), value);
+        if (threaded && idx % 1024 == 1023) {
+            lemma->poll();
+        }
+    }
+    lemma->poll();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    uint64_t allocations = getAllocationCount() - allocationStartCount;
+
+    report(str(boost::format("dispatch %5u names%s") % nameCount % (threaded ? " queued" : "")), elapsed, allocations, handled);
+}
+
+// Event name lookups and dispatch through a lemma, no networking
+int main(int argc, const char* argv[]) {
+    std::atomic<bool> interning(false);
+    for (size_t nameCount : {1, 64, 4096}) {
+        measureLookups(nameCount, nullptr);
+    }
+    measureLookups(64, &interning);
+    for (size_t nameCount : {1, 64, 4096}) {
+        measureDispatch(nameCount, false);
+        measureDispatch(nameCount, true);
+    }
+    return 0;
+}
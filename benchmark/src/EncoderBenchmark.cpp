@@ -0,0 +1,153 @@
+//
+//  EncoderBenchmark.cpp
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "AllocationCounter.h"
+#include "FrameEncoder.h"
+#include "TcpSession.h"
+#include "boost/format.hpp"
+#include "cinder/Json.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+
+using namespace Cinder::Noam;
+
+static const size_t sCalls = 1000 * 1000;
+// NB - the encoder is cleared every so often so the buffer stays warm in cache and never grows after the first round
+static const size_t sCallsPerClear = 1000;
+
+// time and allocations per call of encode, once the encoder's buffer has grown to size
+static void measure(const std::string& name, const std::function<void(FrameEncoder&, size_t)>& encode) {
+    FrameEncoder encoder;
+    for (size_t idx = 0; idx < sCallsPerClear; idx++) {
+        encode(encoder, idx);
+    }
+
+    size_t bytes = 0;
+    uint64_t allocationStartCount = getAllocationCount();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (size_t idx = 0; idx < sCalls; idx++) {
+        if (idx % sCallsPerClear == 0) {
+            bytes += encoder.getSize();
+            encoder.clear();
+        }
+        encode(encoder, idx);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    uint64_t allocations = getAllocationCount() - allocationStartCount;
+    bytes += encoder.getSize();
+
+    std::cout << str(boost::format("%-14s %7.1f ns/call  %5.2f allocations/call  %5.1f bytes/call") % name % (elapsed / sCalls) % (static_cast<double>(allocations) / sCalls) % (static_cast<double>(bytes) / sCalls)) << std::endl;
+}
+
+struct EventCost {
+    double nanoseconds;
+    double allocations;
+    double bytes;
+};
+
+// time, allocations and bytes on the wire per event, send returns the size of the frame it made
+static EventCost measureEvents(const std::function<size_t(size_t)>& send) {
+    for (size_t idx = 0; idx < sCallsPerClear; idx++) {
+        send(idx);
+    }
+
+    size_t bytes = 0;
+    uint64_t allocationStartCount = getAllocationCount();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (size_t idx = 0; idx < sCalls; idx++) {
+        bytes += send(idx);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    uint64_t allocations = getAllocationCount() - allocationStartCount;
+
+    return EventCost{elapsed / sCalls, static_cast<double>(allocations) / sCalls, static_cast<double>(bytes) / sCalls};
+}
+
+static void printEventCost(const std::string& name, const EventCost& cost) {
+    std::cout << str(boost::format("%-14s %7.1f ns/event  %5.2f allocations/event  %5.1f bytes/event") % name % cost.nanoseconds % cost.allocations % cost.bytes) << std::endl;
+}
+
+// FrameEncoder's appendValue() and event frames one call at a time, no networking
+int main(int argc, const char* argv[]) {
+    // NB - drawn up front, the same values for every case
+    std::mt19937 random(1030);
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    std::vector<double> doubles(sCallsPerClear);
+    std::vector<float> floats(sCallsPerClear);
+    for (size_t idx = 0; idx < doubles.size(); idx++) {
+        doubles[idx] = distribution(random);
+        floats[idx] = static_cast<float>(doubles[idx]);
+    }
+    const std::string text = "the quick brown fox jumps over the lazy dog";
+    const std::string escapedText = "Jean-Pierre said \"café\"\n\tand left";
+    const std::string guestName = "cinder-noamprotocol_benchmark";
+    const std::string quotedGuestName = FrameEncoder::quote(guestName);
+    const std::string eventName = "BenchDouble";
+
+    measure("int", [](FrameEncoder& encoder, size_t idx) {
+        encoder.appendValue(static_cast<int>(idx * 7919));
+    });
+    measure("float", [&](FrameEncoder& encoder, size_t idx) {
+        encoder.appendValue(floats[idx % floats.size()]);
+    });
+    measure("double", [&](FrameEncoder& encoder, size_t idx) {
+        encoder.appendValue(doubles[idx % doubles.size()]);
+    });
+    // the formatting FrameEncoder used to do, for comparison
+    measure("double printf", [&](FrameEncoder& encoder, size_t idx) {
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), "%.17g", doubles[idx % doubles.size()]);
+        encoder.appendRaw(buffer, static_cast<size_t>(length));
+    });
+    measure("string", [&](FrameEncoder& encoder, size_t) {
+        encoder.appendValue(text);
+    });
+    measure("escaped", [&](FrameEncoder& encoder, size_t) {
+        encoder.appendValue(escapedText);
+    });
+    measure("event frame", [&](FrameEncoder& encoder, size_t idx) {
+        encoder.beginEventFrame(quotedGuestName, eventName);
+        encoder.appendValue(doubles[idx % doubles.size()]);
+        encoder.endEventFrame();
+    });
+
+    // the same events framed as Lemma sends them and as it used to, a JsonTree per event serialized and copied into
+    //  buffers behind a printf'd length
+    FrameEncoder encoder;
+    EventCost framed = measureEvents([&](size_t idx) {
+        if (idx % sCallsPerClear == 0) {
+            encoder.clear();
+        }
+        size_t start = encoder.getSize();
+        encoder.beginEventFrame(quotedGuestName, eventName);
+        encoder.appendValue(doubles[idx % doubles.size()]);
+        encoder.endEventFrame();
+        return encoder.getSize() - start;
+    });
+    EventCost tree = measureEvents([&](size_t idx) {
+        ci::JsonTree rootArray = ci::JsonTree::makeArray();
+        rootArray.pushBack(ci::JsonTree("", "event"));
+        rootArray.pushBack(ci::JsonTree("", guestName));
+        rootArray.pushBack(ci::JsonTree("", eventName));
+        rootArray.pushBack(ci::JsonTree("", doubles[idx % doubles.size()]));
+        std::string jsonString = rootArray.serialize();
+        ci::Buffer jsonBuffer = TcpSession::stringToBuffer(jsonString);
+        std::string dataString = str(boost::format("%06d") % jsonBuffer.getDataSize()) + jsonString;
+        ci::Buffer dataBuffer = TcpSession::stringToBuffer(dataString);
+        return dataBuffer.getDataSize();
+    });
+    std::cout << std::endl;
+    printEventCost("FrameEncoder", framed);
+    printEventCost("JsonTree", tree);
+    std::cout << str(boost::format("%-14s %7.1fx the time  %5.2f more allocations/event") % "JsonTree cost" % (tree.nanoseconds / framed.nanoseconds) % (tree.allocations - framed.allocations)) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+//
+//  LemmaBenchmark.cpp
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "LemmaBenchmark.h"
+#include "AllocationCounter.h"
+#include "Compressor.h"
+#include "JsonScanner.h"
+#include "cinder/Json.h"
+#include "cinder/Utilities.h"
+#include "boost/format.hpp"
+#include <algorithm>
+
+using namespace ci;
+using namespace Cinder::Noam;
+
+static const uint16_t sHostPort = 7734;
+static const size_t sLatencySamples = 10 * 1000;
+static const size_t sThroughputEvents = 100 * 1000;
+static const size_t sThroughputBatch = 2 * 1000;
+static const double sCaseTimeout = 30.0;
+
+LemmaBenchmark::LemmaBenchmark(boost::asio::io_service& io, const std::function<void(const std::string&)>& reportHandler) : mIoService(io), mReportHandler(reportHandler), mPayloadIndex(0), mPhase(Phase::Connecting), mTimedOut(false), mSent(0), mReceived(0), mCPUStartTime(0), mAllocationStartCount(0) {
+}
+
+void LemmaBenchmark::setup() {
+    mPayloads.push_back({"Int", [](const LemmaRef& lemma, const std::string& eventName) {
+        return lemma->sendMessage(eventName, 42);
+    }});
+    mPayloads.push_back({"String", [](const LemmaRef& lemma, const std::string& eventName) {
+        return lemma->sendMessage(eventName, std::string("the quick brown fox jumps over the lazy dog"));
+    }});
+    // https://github.com/noam-io/host/blob/master/lemma_verification/tests/name.rb
+    JsonTree name = JsonTree::makeObject();
+    name.addChild(JsonTree("firstName", "Jean-Pierre"));
+    name.addChild(JsonTree("lastName", "Mouilleseaux"));
+    mPayloads.push_back({"Name", [name](const LemmaRef& lemma, const std::string& eventName) {
+        return lemma->sendMessage(eventName, name);
+    }});
+    // a tracker's blob list, large and repetitive enough to be compressed
+    JsonTree blobs = JsonTree::makeArray();
+    for (int idx = 0; idx < 32; idx++) {
+        JsonTree blob = JsonTree::makeObject();
+        blob.addChild(JsonTree("id", idx));
+        blob.addChild(JsonTree("x", (idx * 37) % 640));
+        blob.addChild(JsonTree("y", (idx * 53) % 480));
+        blob.addChild(JsonTree("width", 24));
+        blob.addChild(JsonTree("height", 48));
+        blobs.pushBack(blob);
+    }
+    mPayloads.push_back({"Blobs", [blobs](const LemmaRef& lemma, const std::string& eventName) {
+        return lemma->sendMessage(eventName, blobs);
+    }});
+    // multi-kilobyte string and nested object, mostly spent scanning and escaping
+    std::string text;
+    while (text.size() < 4 * 1024) {
+        text += "Jean-Pierre said \"the quick brown fox jumps over the lazy dog\" \u2014 caf\u00e9 au lait\n";
+    }
+    mPayloads.push_back({"Text", [text](const LemmaRef& lemma, const std::string& eventName) {
+        return lemma->sendMessage(eventName, text);
+    }});
+    JsonTree names = JsonTree::makeArray();
+    for (int idx = 0; idx < 64; idx++) {
+        JsonTree entry = JsonTree::makeObject();
+        entry.addChild(JsonTree("firstName", "Jean-Pierre " + toString(idx)));
+        entry.addChild(JsonTree("lastName", "Mouilleseaux"));
+        JsonTree numbers = JsonTree::makeArray("numbers");
+        numbers.pushBack(JsonTree("", idx));
+        numbers.pushBack(JsonTree("", idx * 2));
+        entry.addChild(numbers);
+        names.pushBack(entry);
+    }
+    mPayloads.push_back({"Names", [names](const LemmaRef& lemma, const std::string& eventName) {
+        return lemma->sendMessage(eventName, names);
+    }});
+    mPayloadIndex = 0;
+
+    mHost = Host::create(mIoService, "lemma_benchmark", sHostPort);
+    mHost->begin();
+
+    // NB - the echo lemma returns whatever the driver got through, only the driver is held to a send budget
+    mEcho = Lemma::create("cinder-noamprotocol_benchmark_echo", "lemma_benchmark", Lemma::Format().ioService(mIoService).sendBudget(0));
+    mDriver = Lemma::create("cinder-noamprotocol_benchmark_driver", "lemma_benchmark", Lemma::Format().ioService(mIoService));
+    for (const Payload& payload : mPayloads) {
+        std::string eventName = "Bench" + payload.name;
+        // NB - named up front so echoing does not allocate
+        std::string echoName = eventName + "Echo";
+        mEcho->connectMessageEventHandler(eventName, [&, echoName](const std::string&, const EventValue& eventValue) {
+            mEcho->sendMessage(echoName, eventValue);
+        });
+        mDriver->connectMessageEventHandler(echoName, [&](const std::string&, const EventValue&) {
+            mReceived++;
+            if (mPhase == Phase::Latency) {
+                mRoundTrips.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - mProbeTime).count());
+                if (mRoundTrips.size() < sLatencySamples) {
+                    sendLatencyProbe();
+                }
+            }
+        });
+    }
+    mEcho->begin("127.0.0.1", sHostPort);
+    mDriver->begin("127.0.0.1", sHostPort);
+
+    mPhase = Phase::Connecting;
+    mPhaseStartTime = std::chrono::steady_clock::now();
+    report("connecting to local host on port " + toString(sHostPort) + ", scanning JSON with " + JsonScanner::getInstructionSet() + ", " + (Compressor::isAvailable() ? "compressing large frames" : "built without compression"));
+}
+
+void LemmaBenchmark::update() {
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - mPhaseStartTime).count();
+
+    switch (mPhase) {
+        case Phase::Connecting:
+            // NB - the host only forwards once it has connected back to both guests
+            if (mDriver->isConnected() && mEcho->isConnected() && mHost->getGuestCount() == 2 && elapsed > 1.0) {
+                beginLatency();
+            } else if (elapsed > sCaseTimeout) {
+                report("failed to connect to the local host");
+                mTimedOut = true;
+                mPhase = Phase::Done;
+            }
+            break;
+        case Phase::Latency:
+            if (mRoundTrips.size() >= sLatencySamples || elapsed > sCaseTimeout) {
+                finishLatency();
+            }
+            break;
+        case Phase::Throughput:
+            if (mSent < sThroughputEvents && mSent - mReceived < 4 * sThroughputBatch) {
+                // a rejected send means the driver is over its send budget, the rest of the batch waits for the next update
+                size_t count = std::min(sThroughputBatch, sThroughputEvents - mSent);
+                for (size_t idx = 0; idx < count && getPayload().send(mDriver, getEventName()) != SendStatus::Rejected; idx++) {
+                    mSent++;
+                }
+            }
+            if (mReceived >= sThroughputEvents || elapsed > sCaseTimeout) {
+                finishThroughput();
+            }
+            break;
+        case Phase::Done:
+            break;
+    }
+}
+
+#pragma mark -
+
+void LemmaBenchmark::beginLatency() {
+    mPhase = Phase::Latency;
+    mPhaseStartTime = std::chrono::steady_clock::now();
+    mRoundTrips.clear();
+    mRoundTrips.reserve(sLatencySamples);
+    mReceived = 0;
+    sendLatencyProbe();
+}
+
+void LemmaBenchmark::sendLatencyProbe() {
+    mProbeTime = std::chrono::steady_clock::now();
+    getPayload().send(mDriver, getEventName());
+}
+
+void LemmaBenchmark::finishLatency() {
+    std::vector<double> roundTrips = mRoundTrips;
+    std::sort(roundTrips.begin(), roundTrips.end());
+    auto percentile = [&](double p) {
+        return roundTrips.empty() ? 0.0 : roundTrips[std::min(roundTrips.size() - 1, static_cast<size_t>(p * roundTrips.size()))];
+    };
+    mTimedOut |= roundTrips.size() < sLatencySamples;
+    report(str(boost::format("%-6s round trip  n %6u  p50 %8.1f us  p99 %8.1f us  p999 %8.1f us") % getPayload().name % roundTrips.size() % percentile(0.5) % percentile(0.99) % percentile(0.999)));
+
+    beginThroughput();
+}
+
+void LemmaBenchmark::beginThroughput() {
+    mPhase = Phase::Throughput;
+    mPhaseStartTime = std::chrono::steady_clock::now();
+    mSent = 0;
+    mReceived = 0;
+    mCPUStartTime = std::clock();
+    mAllocationStartCount = getAllocationCount();
+    mWriteStartStats = mDriver->getWriteStats();
+}
+
+void LemmaBenchmark::finishThroughput() {
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - mPhaseStartTime).count();
+    double cpu = static_cast<double>(std::clock() - mCPUStartTime) / CLOCKS_PER_SEC;
+    uint64_t allocations = getAllocationCount() - mAllocationStartCount;
+    WriteQueue::Stats writeStats = mDriver->getWriteStats();
+    uint64_t frames = writeStats.frames - mWriteStartStats.frames;
+    uint64_t bytes = writeStats.bytes - mWriteStartStats.bytes;
+    // NB - only non-zero when built with NOAM_ENABLE_COMPRESSION, CPU/event then includes compressing and decompressing
+    uint64_t savedBytes = writeStats.compressionSavedBytes - mWriteStartStats.compressionSavedBytes;
+
+    // NB - per event sent, allocations and CPU cover the driver, the host and the echo lemma
+    double events = static_cast<double>(std::max<size_t>(mReceived, 1));
+    mTimedOut |= mReceived < sThroughputEvents;
+    report(str(boost::format("%-6s throughput  %9.0f events/s  %6.1f bytes/event  %5.1f%% saved  %6.2f allocations/event  %6.2f us CPU/event%s") % getPayload().name % (mReceived / elapsed) % (frames ? static_cast<double>(bytes) / frames : 0.0) % (bytes + savedBytes ? 100.0 * savedBytes / (bytes + savedBytes) : 0.0) % (allocations / events) % (cpu * 1.0e6 / events) % (mReceived < sThroughputEvents ? "  (timed out)" : "")));
+
+    nextPayload();
+}
+
+void LemmaBenchmark::nextPayload() {
+    if (++mPayloadIndex < mPayloads.size()) {
+        beginLatency();
+        return;
+    }
+
+    mPhase = Phase::Done;
+    report("done");
+}
+
+void LemmaBenchmark::report(const std::string& line) {
+    if (mReportHandler) {
+        mReportHandler(line);
+    }
+}
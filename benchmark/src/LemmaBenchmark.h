@@ -0,0 +1,70 @@
+//
+//  LemmaBenchmark.h
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "Cinder-NoamProtocol.h"
+#include <chrono>
+#include <ctime>
+#include <functional>
+
+// Round trip latency and throughput of each payload between two lemmas and an in-process host, over TCP on loopback.
+//  Everything runs on the given io_service, whoever runs it calls update() in between, e.g. once a frame, until isDone().
+class LemmaBenchmark {
+public:
+    LemmaBenchmark(boost::asio::io_service& io, const std::function<void(const std::string&)>& reportHandler);
+
+    void setup();
+    void update();
+
+    inline bool isDone() const { return mPhase == Phase::Done; }
+    // a case that did not finish within its time, the results are then partial
+    inline bool hasTimedOut() const { return mTimedOut; }
+
+private:
+    enum class Phase { Connecting, Latency, Throughput, Done };
+
+    struct Payload {
+        std::string name;
+        std::function<Cinder::Noam::SendStatus(const Cinder::Noam::LemmaRef&, const std::string&)> send;
+    };
+
+    void beginLatency();
+    void sendLatencyProbe();
+    void finishLatency();
+    void beginThroughput();
+    void finishThroughput();
+    void nextPayload();
+    void report(const std::string& line);
+
+    inline const Payload& getPayload() const { return mPayloads[mPayloadIndex]; }
+    inline std::string getEventName() const { return "Bench" + getPayload().name; }
+
+    boost::asio::io_service& mIoService;
+    std::function<void(const std::string&)> mReportHandler;
+
+    Cinder::Noam::HostRef mHost;
+    // sends payloads and receives them back from the echo lemma, each round trip passes through the host twice
+    Cinder::Noam::LemmaRef mDriver;
+    Cinder::Noam::LemmaRef mEcho;
+
+    std::vector<Payload> mPayloads;
+    size_t mPayloadIndex;
+    Phase mPhase;
+    std::chrono::steady_clock::time_point mPhaseStartTime;
+    bool mTimedOut;
+
+    std::vector<double> mRoundTrips;
+    std::chrono::steady_clock::time_point mProbeTime;
+
+    size_t mSent;
+    size_t mReceived;
+    std::clock_t mCPUStartTime;
+    uint64_t mAllocationStartCount;
+    Cinder::Noam::WriteQueue::Stats mWriteStartStats;
+};
@@ -0,0 +1,62 @@
+//
+//  LemmaBenchmarkApp.cpp
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "cinder/app/AppNative.h"
+#include "cinder/gl/gl.h"
+#include "LemmaBenchmark.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+class LemmaBenchmarkApp : public AppNative {
+public:
+    void prepareSettings(Settings* settings);
+    void setup();
+    void update();
+    void draw();
+
+private:
+    std::unique_ptr<LemmaBenchmark> mBenchmark;
+    std::vector<std::string> mResults;
+};
+
+void LemmaBenchmarkApp::prepareSettings(Settings* settings) {
+    settings->setWindowSize(900, 360);
+    // NB - the lemmas and host share the app's io_service, spin the run loop rather than waiting on the display
+    settings->setFrameRate(1000.0f);
+}
+
+void LemmaBenchmarkApp::setup() {
+    gl::enableVerticalSync(false);
+
+    mBenchmark.reset(new LemmaBenchmark(io_service(), [&](const std::string& line) {
+        console() << line << std::endl;
+        mResults.push_back(line);
+    }));
+    mBenchmark->setup();
+}
+
+void LemmaBenchmarkApp::update() {
+    mBenchmark->update();
+    if (mBenchmark->isDone()) {
+        quit();
+    }
+}
+
+void LemmaBenchmarkApp::draw() {
+    gl::clear();
+
+    Vec2f position(10.0f, 10.0f);
+    for (const std::string& line : mResults) {
+        gl::drawString(line, position);
+        position.y += 14.0f;
+    }
+}
+
+CINDER_APP_NATIVE(LemmaBenchmarkApp, RendererGl)
@@ -0,0 +1,41 @@
+//
+//  LemmaBenchmarkHeadless.cpp
+//  LemmaBenchmark
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "LemmaBenchmark.h"
+#include <boost/asio/steady_timer.hpp>
+#include <iostream>
+
+// The app's benchmark without a window, e.g. on a CI machine. Exits non-zero when a case timed out.
+int main(int argc, const char* argv[]) {
+    boost::asio::io_service io;
+    LemmaBenchmark benchmark(io, [](const std::string& line) {
+        std::cout << line << std::endl;
+    });
+    benchmark.setup();
+
+    // NB - stands in for the app's frame loop, update() runs every millisecond in between the networking handlers
+    boost::asio::steady_timer timer(io);
+    std::function<void()> scheduleUpdate = [&]() {
+        timer.expires_from_now(std::chrono::milliseconds(1));
+        timer.async_wait([&](const boost::system::error_code& err) {
+            if (err) {
+                return;
+            }
+            benchmark.update();
+            if (benchmark.isDone()) {
+                io.stop();
+            } else {
+                scheduleUpdate();
+            }
+        });
+    };
+    scheduleUpdate();
+    io.run();
+
+    return benchmark.hasTimedOut() ? 1 : 0;
+}
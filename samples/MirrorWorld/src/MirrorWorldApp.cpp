@@ -10,7 +10,9 @@
 #include "cinder/gl/gl.h"
 #include "cinder/Utilities.h"
 #include "Cinder-NoamProtocol.h"
-#include "cinder/Json.h"
+
+// points travel as {"x":..., "y":...} objects
+NOAM_FIELDS(ci::Vec2f, x, y)
 
 using namespace ci;
 using namespace ci::app;
@@ -26,6 +28,8 @@ public:
     void draw();
 
 private:
+    HostRef mHost;
+
     LemmaRef mLemmaNorth;
     Vec2f mPointNorth;
     Color mColorNorth;
@@ -42,22 +46,24 @@ void MirrorWorldApp::prepareSettings(Settings* settings) {
 }
 
 void MirrorWorldApp::setup() {
+    // both worlds live in this process, so does the host they talk through, without going through sockets
+    mHost = Host::create();
+    mHost->begin();
+
     mLemmaNorth = Lemma::create("North");
-    mLemmaNorth->connectMessageEventHandler("southPoint", [&](const std::string& eventName, const std::string& eventValue) {
-        JsonTree object = JsonTree(eventValue);
-        mPointNorth = Vec2f(object.getValueForKey<float>("x"), object.getValueForKey<float>("y"));
+    mLemmaNorth->connectMessageEventHandler<Vec2f>("southPoint", [&](const std::string& eventName, const Vec2f& point) {
+        mPointNorth = point;
         mColorNorth = Color(0, 1, 1);
     });
-    mLemmaNorth->begin();
+    mLemmaNorth->begin(mHost->getLoopbackHub()->createTransport());
     mPointNorth = Vec2f(-50.0f, -50.0f);
 
     mLemmaSouth = Lemma::create("South");
-    mLemmaSouth->connectMessageEventHandler("northPoint", [&](const std::string& eventName, const std::string& eventValue) {
-        JsonTree object = JsonTree(eventValue);
-        mPointSouth = Vec2f(object.getValueForKey<float>("x"), object.getValueForKey<float>("y"));
+    mLemmaSouth->connectMessageEventHandler<Vec2f>("northPoint", [&](const std::string& eventName, const Vec2f& point) {
+        mPointSouth = point;
         mColorSouth = Color(1, 0, 1);
     });
-    mLemmaSouth->begin();
+    mLemmaSouth->begin(mHost->getLoopbackHub()->createTransport());
     mPointSouth = Vec2f(-50.0f, -50.0f);
 }
 
@@ -69,10 +75,7 @@ void MirrorWorldApp::mouseDown(MouseEvent event) {
         if (!mLemmaNorth->isConnected()) {
             return;
         }
-        JsonTree object = JsonTree::makeObject();
-        object.addChild(JsonTree("x", mPointNorth.x));
-        object.addChild(JsonTree("y", mPointNorth.y));
-        mLemmaNorth->sendMessage("northPoint", object);
+        mLemmaNorth->sendMessage("northPoint", mPointNorth);
     } else {
         mPointSouth = Vec2f(event.getX(), event.getY() - getWindowHeight() / 2.0f);
         mColorSouth = Color(0, 0, 1);
@@ -80,10 +83,7 @@ void MirrorWorldApp::mouseDown(MouseEvent event) {
         if (!mLemmaSouth->isConnected()) {
             return;
         }
-        JsonTree object = JsonTree::makeObject();
-        object.addChild(JsonTree("x", mPointSouth.x));
-        object.addChild(JsonTree("y", mPointSouth.y));
-        mLemmaSouth->sendMessage("southPoint", object);
+        mLemmaSouth->sendMessage("southPoint", mPointSouth);
     }
 }
 
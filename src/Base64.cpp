@@ -0,0 +1,87 @@
+//
+//  Base64.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Base64.h"
+
+namespace Cinder { namespace Noam {
+
+static const char sAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static inline int decodeCharacter(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    } else if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    } else if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    } else if (c == '+') {
+        return 62;
+    } else if (c == '/') {
+        return 63;
+    }
+    return -1;
+}
+
+void Base64::encode(const uint8_t* data, size_t size, char* output) {
+    size_t idx = 0;
+    for (; idx + 3 <= size; idx += 3) {
+        uint32_t triple = (static_cast<uint32_t>(data[idx]) << 16) | (static_cast<uint32_t>(data[idx + 1]) << 8) | data[idx + 2];
+        *output++ = sAlphabet[(triple >> 18) & 0x3F];
+        *output++ = sAlphabet[(triple >> 12) & 0x3F];
+        *output++ = sAlphabet[(triple >> 6) & 0x3F];
+        *output++ = sAlphabet[triple & 0x3F];
+    }
+
+    size_t remaining = size - idx;
+    if (remaining) {
+        uint32_t triple = static_cast<uint32_t>(data[idx]) << 16;
+        if (remaining == 2) {
+            triple |= static_cast<uint32_t>(data[idx + 1]) << 8;
+        }
+        *output++ = sAlphabet[(triple >> 18) & 0x3F];
+        *output++ = sAlphabet[(triple >> 12) & 0x3F];
+        *output++ = remaining == 2 ? sAlphabet[(triple >> 6) & 0x3F] : '=';
+        *output++ = '=';
+    }
+}
+
+size_t Base64::getDecodedSize(const char* data, size_t size) {
+    size_t padding = 0;
+    while (padding < 2 && padding < size && data[size - 1 - padding] == '=') {
+        padding++;
+    }
+    return (size + 3) / 4 * 3 - padding;
+}
+
+bool Base64::decode(const char* data, size_t size, uint8_t* output, size_t& outputSize) {
+    outputSize = 0;
+    uint32_t accumulator = 0;
+    size_t bits = 0;
+    size_t idx = 0;
+    for (; idx < size && data[idx] != '='; idx++) {
+        int value = decodeCharacter(data[idx]);
+        if (value < 0) {
+            return false;
+        }
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            output[outputSize++] = static_cast<uint8_t>((accumulator >> bits) & 0xFF);
+        }
+    }
+    // only padding may follow, and a lone trailing character carries no whole byte
+    for (; idx < size; idx++) {
+        if (data[idx] != '=') {
+            return false;
+        }
+    }
+    return bits < 6;
+}
+
+}}
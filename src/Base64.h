@@ -0,0 +1,28 @@
+//
+//  Base64.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Cinder { namespace Noam {
+
+// Standard alphabet with padding, encodes into and decodes from caller provided buffers.
+class Base64 {
+public:
+    static inline size_t getEncodedSize(size_t size) { return (size + 2) / 3 * 4; }
+    static void encode(const uint8_t* data, size_t size, char* output);
+
+    // upper bound, exact for padded input
+    static size_t getDecodedSize(const char* data, size_t size);
+    // false on characters outside the alphabet or a truncated quantum, outputSize is the number of bytes written
+    static bool decode(const char* data, size_t size, uint8_t* output, size_t& outputSize);
+};
+
+}}
@@ -8,4 +8,8 @@
 
 #pragma once
 
+#include "Log.h"
 #include "Lemma.h"
+#include "LemmaPool.h"
+#include "Host.h"
+#include "LoopbackTransport.h"
@@ -0,0 +1,151 @@
+//
+//  Compressor.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Compressor.h"
+#include "FrameDecoder.h"
+#include <algorithm>
+#if NOAM_ENABLE_COMPRESSION
+    #include <zlib.h>
+#endif
+
+namespace Cinder { namespace Noam {
+
+const char Compressor::sFrameMarker;
+
+#if NOAM_ENABLE_COMPRESSION
+
+// NB - both ends must use the very same bytes, changing them breaks compatibility with older peers.
+//  Most likely matches go last, deflate favors the nearest
+static const char sDictionary[] = "null,false,true,\"id\":,\"name\":,\"type\":,\"value\":,\"data\":,\"width\":,\"height\":,\"z\":,\"y\":,\"x\":,\"heartbeat\",[\"event\",\"";
+
+struct Compressor::Streams {
+    Streams() : deflating(false), inflating(false) {}
+
+    z_stream deflater;
+    z_stream inflater;
+    bool deflating;
+    bool inflating;
+};
+
+bool Compressor::isAvailable() {
+    return true;
+}
+
+Compressor::Compressor() : mStreams(new Streams()), mOutputSize(0) {
+}
+
+Compressor::~Compressor() {
+    if (mStreams->deflating) {
+        deflateEnd(&mStreams->deflater);
+    }
+    if (mStreams->inflating) {
+        inflateEnd(&mStreams->inflater);
+    }
+}
+
+#pragma mark -
+
+bool Compressor::compress(const char* data, size_t size) {
+    z_stream& stream = mStreams->deflater;
+    if (!mStreams->deflating) {
+        stream = z_stream();
+        // NB - fastest level, frames are small and latency matters more than the last few percent
+        if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        mStreams->deflating = true;
+    } else if (deflateReset(&stream) != Z_OK) {
+        return false;
+    }
+    deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(sDictionary), sizeof(sDictionary) - 1);
+
+    mOutput.resize(std::max<size_t>(mOutput.size(), deflateBound(&stream, static_cast<uLong>(size))));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = reinterpret_cast<Bytef*>(mOutput.data());
+    stream.avail_out = static_cast<uInt>(mOutput.size());
+    if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+        return false;
+    }
+    mOutputSize = mOutput.size() - stream.avail_out;
+
+    // the marker costs a byte
+    return mOutputSize + 1 < size;
+}
+
+bool Compressor::decompress(const char* data, size_t size) {
+    z_stream& stream = mStreams->inflater;
+    if (!mStreams->inflating) {
+        stream = z_stream();
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            return false;
+        }
+        mStreams->inflating = true;
+    } else if (inflateReset(&stream) != Z_OK) {
+        return false;
+    }
+    // NB - a raw stream takes its dictionary up front rather than on Z_NEED_DICT
+    inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(sDictionary), sizeof(sDictionary) - 1);
+
+    if (mOutput.size() < 4 * size + 256) {
+        mOutput.resize(4 * size + 256);
+    }
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    mOutputSize = 0;
+    while (true) {
+        stream.next_out = reinterpret_cast<Bytef*>(mOutput.data() + mOutputSize);
+        stream.avail_out = static_cast<uInt>(mOutput.size() - mOutputSize);
+        int status = inflate(&stream, Z_NO_FLUSH);
+        mOutputSize = mOutput.size() - stream.avail_out;
+        if (status == Z_STREAM_END) {
+            return true;
+        }
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            return false;
+        }
+        if (stream.avail_out != 0) {
+            // input ran out before the end of the stream
+            return false;
+        }
+        // the original frame fit, anything larger is corrupt or hostile
+        if (mOutput.size() > FrameDecoder::sMaxFrameLength) {
+            return false;
+        }
+        mOutput.resize(std::min(2 * mOutput.size(), FrameDecoder::sMaxFrameLength + 1));
+    }
+}
+
+#else
+
+struct Compressor::Streams {
+};
+
+bool Compressor::isAvailable() {
+    return false;
+}
+
+Compressor::Compressor() : mOutputSize(0) {
+}
+
+Compressor::~Compressor() {
+}
+
+#pragma mark -
+
+bool Compressor::compress(const char*, size_t) {
+    return false;
+}
+
+bool Compressor::decompress(const char*, size_t) {
+    return false;
+}
+
+#endif
+
+}}
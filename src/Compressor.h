@@ -0,0 +1,51 @@
+//
+//  Compressor.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// compression needs zlib, define as 1 in the project's preprocessor macros and link libz to enable it
+#ifndef NOAM_ENABLE_COMPRESSION
+    #define NOAM_ENABLE_COMPRESSION 0
+#endif
+
+namespace Cinder { namespace Noam {
+
+// Per-frame raw deflate with a preset dictionary of common Noam tokens, streams are reset rather than recreated per frame.
+//  A compressed frame is the marker byte followed by the deflated JSON, JSON frames always start with '[' so the two never
+//  mix up. Only ever sent to peers that advertised support in their registration options. Not thread safe, one per side.
+class Compressor {
+public:
+    static const char sFrameMarker = 'z';
+
+    static bool isAvailable();
+    // as advertised in the registration options
+    static const char* getName() { return "deflate"; }
+
+    Compressor();
+    ~Compressor();
+
+    // false if the result would not be smaller, the output is valid until the next call
+    bool compress(const char* data, size_t size);
+    // data excludes the marker, false on corrupt input or output larger than a frame allows
+    bool decompress(const char* data, size_t size);
+
+    inline const char* getData() const { return mOutput.data(); }
+    inline size_t getSize() const { return mOutputSize; }
+
+private:
+    struct Streams;
+    std::unique_ptr<Streams> mStreams;
+    std::vector<char> mOutput;
+    size_t mOutputSize;
+};
+
+}}
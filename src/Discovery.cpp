@@ -0,0 +1,188 @@
+//
+//  Discovery.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Discovery.h"
+#include "Log.h"
+#include "cinder/Json.h"
+
+namespace Cinder { namespace Noam {
+
+using namespace ci;
+
+static const std::string sAvailabilityBroadcastHost = "255.255.255.255";
+static const uint16_t sAvailabilityBroadcastPort = 1030;
+static const std::string sAvailabilityBroadcastResponseHeader = "polo";
+
+DiscoveryRef Discovery::create(boost::asio::io_service& io, const DiscoverySchedule::Format& format) {
+    return DiscoveryRef(new Discovery(io, format));
+}
+
+Discovery::Discovery(boost::asio::io_service& io, const DiscoverySchedule::Format& format) : mIoService(io), mRunning(false), mSchedule(format), mNetworkError(false) {
+}
+
+Discovery::~Discovery() {
+    close();
+
+    mAvailabilityBroadcastTimer = nullptr;
+    mUDPClient = nullptr;
+    mUDPClientSession = nullptr;
+    mUDPServer = nullptr;
+    mUDPServerSession = nullptr;
+}
+
+#pragma mark -
+
+void Discovery::start(const std::string& availabilityMessage) {
+    close();
+
+    mRunning = true;
+    mAvailabilityMessage = availabilityMessage;
+    setupClient();
+}
+
+void Discovery::stop() {
+    mRunning = false;
+}
+
+void Discovery::close() {
+    mRunning = false;
+
+    if (mUDPClientSession && mUDPClientSession->getSocket()->is_open()) {
+        boost::system::error_code err;
+        mUDPClientSession->getSocket()->close(err);
+        if (err) {
+            NOAM_LOG_ERROR("UDP client session failed to close - " << err);
+        }
+    }
+    if (mUDPServerSession && mUDPServerSession->getSocket()->is_open()) {
+        boost::system::error_code err;
+        mUDPServerSession->getSocket()->close(err);
+        if (err) {
+            NOAM_LOG_ERROR("UDP server session failed to close - " << err);
+        }
+    }
+}
+
+#pragma mark -
+
+void Discovery::setupClient() {
+    // NB - started on begin() and after losing the host, either way a host is worth looking for eagerly again
+    mSchedule.reset();
+    mNetworkError = false;
+
+    mAvailabilityBroadcastTimer = WaitTimer::create(mIoService);
+    mAvailabilityBroadcastTimer->connectErrorEventHandler([](std::string message, size_t arg) {
+        NOAM_LOG_ERROR("availabilty broadcast timer - " << message << " " << arg);
+    });
+    mAvailabilityBroadcastTimer->connectWaitEventHandler([&]() {
+        sendAvailabilityBroadcast();
+    });
+
+    mUDPClient = UdpClient::create(mIoService);
+    mUDPClient->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("UDP client - " << err);
+    });
+    mUDPClient->connectConnectEventHandler([&](UdpSessionRef session) {
+        mUDPClientSession = session;
+        mUDPClientSession->connectErrorEventHandler([&](std::string err, size_t bytesTransferred) {
+            NOAM_LOG_ERROR("UDP client session - " << err);
+            mNetworkError = true;
+        });
+        mUDPClientSession->connectWriteEventHandler([&](size_t bytesTransferred) {
+            NOAM_LOG_NOTICE("UDP client session wrote " << bytesTransferred << " bytes");
+            if (mNetworkError) {
+                // the network came back, possibly a different one, the host may well be right there
+                mNetworkError = false;
+                mSchedule.reset();
+            }
+        });
+
+        // enable broadcast
+        boost::asio::socket_base::broadcast broadcastOption(true);
+        mUDPClientSession->getSocket()->set_option(broadcastOption);
+
+        // enable address reuse
+        boost::asio::socket_base::reuse_address addressOption(true);
+        boost::system::error_code errorCode;
+        mUDPClientSession->getSocket()->set_option(addressOption, errorCode);
+        if (errorCode) {
+            NOAM_LOG_ERROR("UDP client session failed to enable address reuse " << errorCode);
+        }
+
+        unsigned short localPort = mUDPClientSession->getSocket()->local_endpoint().port();
+        NOAM_LOG_NOTICE("UDP client session sending from port " << localPort);
+
+        setupServer(static_cast<uint16_t>(localPort));
+
+        // TODO - wait until server is setup?
+        sendAvailabilityBroadcast();
+    });
+    mUDPClient->connectResolveEventHandler([]() {
+        NOAM_LOG_NOTICE("UDP client endpoint resolved");
+    });
+
+    mUDPClient->connect(sAvailabilityBroadcastHost, sAvailabilityBroadcastPort);
+}
+
+void Discovery::setupServer(uint16_t port) {
+    mUDPServer = UdpServer::create(mIoService);
+    mUDPServer->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("UDP server - " << err);
+    });
+    mUDPServer->connectAcceptEventHandler([&](UdpSessionRef session) {
+        mUDPServerSession = session;
+        UdpSession* current = session.get();
+        mUDPServerSession->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+            NOAM_LOG_ERROR("UDP server session - " << err);
+        });
+        mUDPServerSession->connectReadEventHandler([&, current](ci::Buffer buffer) {
+            boost::asio::ip::udp::endpoint endpoint = mUDPServerSession->getRemoteEndpoint();
+            std::string response = UdpSession::bufferToString(buffer);
+            NOAM_LOG_NOTICE("host server response - " << response << "\" from " << endpoint);
+            JsonTree data = JsonTree(response);
+            if (data.getNumChildren() != 3) {
+                NOAM_LOG_ERROR("host server response has an invalid number of children - " << data.getNumChildren());
+            } else {
+                std::string header = data.getValueAtIndex<std::string>(0);
+                if (header != sAvailabilityBroadcastResponseHeader) {
+                    NOAM_LOG_ERROR("host server response has an unknown header - " << header);
+                } else if (mRunning) {
+                    uint16_t port = data.getValueAtIndex<uint16_t>(2);
+                    mSchedule.markDiscovered();
+                    if (mHostEventHandler) {
+                        mHostEventHandler(endpoint.address().to_string(), port);
+                    }
+                }
+            }
+
+            // NB - every broadcast may be answered, and by more than one host. Unless the handler started over
+            if (mUDPServerSession.get() == current && current->getSocket()->is_open()) {
+                current->read();
+            }
+        });
+
+        mUDPServerSession->read();
+    });
+
+    // listen on client send port
+    mUDPServer->accept(port);
+    NOAM_LOG_NOTICE("UDP server listening on port " << port);
+}
+
+void Discovery::sendAvailabilityBroadcast() {
+    if (!mRunning || !mUDPClientSession) {
+        return;
+    }
+
+    Buffer buffer = UdpSession::stringToBuffer(mAvailabilityMessage);
+    mUDPClientSession->write(buffer);
+
+    mAvailabilityBroadcastTimer->wait(mSchedule.next(), false);
+}
+
+}}
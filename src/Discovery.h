@@ -0,0 +1,61 @@
+//
+//  Discovery.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "WaitTimer.h"
+#include "UdpClient.h"
+#include "UdpServer.h"
+#include "DiscoverySchedule.h"
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class Discovery> DiscoveryRef;
+
+// The guest side of discovery. Broadcasts availability ("marco") on the schedule and listens for host responses ("polo")
+//  on the port broadcast from until stopped. A lone lemma owns one, the lemmas of a LemmaPool share the pool's.
+class Discovery {
+public:
+    static DiscoveryRef create(boost::asio::io_service& io, const DiscoverySchedule::Format& format = DiscoverySchedule::Format());
+    ~Discovery();
+
+    // starts over, the schedule included, broadcasting the availability message as is
+    void start(const std::string& availabilityMessage);
+    // no more broadcasts and responses are ignored, the sockets stay open until close() or the next start()
+    void stop();
+    void close();
+
+    inline bool isRunning() const { return mRunning; }
+    inline const DiscoverySchedule::Stats& getStats() const { return mSchedule.getStats(); }
+
+    // host address and messaging port, for every response until stopped
+    void connectHostEventHandler(const std::function<void(const std::string&, uint16_t)>& eventHandler) { mHostEventHandler = eventHandler; }
+
+private:
+    Discovery(boost::asio::io_service& io, const DiscoverySchedule::Format& format);
+
+    void setupClient();
+    void setupServer(uint16_t port);
+    void sendAvailabilityBroadcast();
+
+    boost::asio::io_service& mIoService;
+    bool mRunning;
+    std::string mAvailabilityMessage;
+    DiscoverySchedule mSchedule;
+    bool mNetworkError;
+
+    WaitTimerRef mAvailabilityBroadcastTimer;
+    UdpClientRef mUDPClient;
+    UdpSessionRef mUDPClientSession;
+    UdpServerRef mUDPServer;
+    UdpSessionRef mUDPServerSession;
+
+    std::function<void(const std::string&, uint16_t)> mHostEventHandler;
+};
+
+}}
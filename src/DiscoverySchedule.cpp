@@ -0,0 +1,57 @@
+//
+//  DiscoverySchedule.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "DiscoverySchedule.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+DiscoverySchedule::DiscoverySchedule(const Format& format) : mFormat(format), mStep(0), mInterval(0.0), mDiscovered(false), mRandom(std::random_device()()) {
+    reset();
+}
+
+void DiscoverySchedule::reset() {
+    mStep = 0;
+    mInterval = static_cast<double>(mFormat.getInitialInterval());
+    mDiscovered = false;
+    mResetTime = std::chrono::steady_clock::now();
+}
+
+size_t DiscoverySchedule::next() {
+    mStats.broadcasts++;
+
+    const std::vector<size_t>& burst = mFormat.getBurst();
+    if (mStep < burst.size()) {
+        return burst[mStep++];
+    }
+
+    double maxInterval = static_cast<double>(mFormat.getMaxInterval());
+    double interval = std::min(mInterval, maxInterval);
+    mInterval = std::min(mInterval * mFormat.getMultiplier(), maxInterval);
+
+    double jitter = std::max(0.0, std::min(mFormat.getJitter(), 1.0));
+    if (jitter > 0.0) {
+        std::uniform_real_distribution<double> distribution(1.0 - jitter, 1.0 + jitter);
+        interval *= distribution(mRandom);
+    }
+    return std::max<size_t>(static_cast<size_t>(interval), 1);
+}
+
+void DiscoverySchedule::markDiscovered() {
+    if (mDiscovered) {
+        return;
+    }
+    mDiscovered = true;
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - mResetTime).count();
+    mStats.discoveries++;
+    mStats.lastTimeToDiscover = elapsed;
+    mStats.maxTimeToDiscover = std::max(mStats.maxTimeToDiscover, elapsed);
+}
+
+}}
@@ -0,0 +1,82 @@
+//
+//  DiscoverySchedule.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Cinder { namespace Noam {
+
+// Intervals between availability broadcasts. A short burst finds a host that is already up quickly, after that the
+//  interval grows exponentially up to a ceiling so a subnet full of guests stays quiet while the host is down. Each backoff
+//  interval is jittered so guests started together spread out.
+class DiscoverySchedule {
+public:
+    class Format {
+    public:
+        Format() : mBurst({50, 100, 200}), mInitialInterval(500), mMaxInterval(10 * 1000), mMultiplier(2.0), mJitter(0.2) {}
+
+        // intervals in milliseconds following the first broadcast
+        Format& burst(const std::vector<size_t>& intervals) { mBurst = intervals; return *this; }
+        // first interval once the burst is over
+        Format& initialInterval(size_t millis) { mInitialInterval = millis; return *this; }
+        Format& maxInterval(size_t millis) { mMaxInterval = millis; return *this; }
+        Format& multiplier(double multiplier) { mMultiplier = multiplier; return *this; }
+        // fraction of a backoff interval it may randomly be shortened or lengthened by
+        Format& jitter(double fraction) { mJitter = fraction; return *this; }
+
+        inline const std::vector<size_t>& getBurst() const { return mBurst; }
+        inline size_t getInitialInterval() const { return mInitialInterval; }
+        inline size_t getMaxInterval() const { return mMaxInterval; }
+        inline double getMultiplier() const { return mMultiplier; }
+        inline double getJitter() const { return mJitter; }
+
+    private:
+        std::vector<size_t> mBurst;
+        size_t mInitialInterval;
+        size_t mMaxInterval;
+        double mMultiplier;
+        double mJitter;
+    };
+
+    struct Stats {
+        Stats() : broadcasts(0), discoveries(0), lastTimeToDiscover(0.0), maxTimeToDiscover(0.0) {}
+
+        uint64_t broadcasts;
+        uint64_t discoveries;
+        // seconds from a reset until a host responded
+        double lastTimeToDiscover;
+        double maxTimeToDiscover;
+    };
+
+    explicit DiscoverySchedule(const Format& format = Format());
+
+    // starts over with the burst, on begin() and whenever the host or the network went away
+    void reset();
+    // counts a broadcast and returns the milliseconds to wait before the next one
+    size_t next();
+    // a host responded, only the first response after a reset is measured
+    void markDiscovered();
+
+    inline const Format& getFormat() const { return mFormat; }
+    inline const Stats& getStats() const { return mStats; }
+
+private:
+    Format mFormat;
+    size_t mStep;
+    double mInterval;
+    bool mDiscovered;
+    std::chrono::steady_clock::time_point mResetTime;
+    std::minstd_rand mRandom;
+    Stats mStats;
+};
+
+}}
@@ -0,0 +1,97 @@
+//
+//  EventQueue.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "EventQueue.h"
+
+namespace Cinder { namespace Noam {
+
+QueuedEvent::QueuedEvent() : mType(EventValue::Type::Null), mInt(0) {
+}
+
+void QueuedEvent::assign(const boost::string_ref& eventName, const EventValue& eventValue) {
+    mEventName.assign(eventName.data(), eventName.size());
+    mType = eventValue.getType();
+    switch (mType) {
+        case EventValue::Type::Bool: mBool = eventValue.asBool(); break;
+        case EventValue::Type::Int: mInt = eventValue.asInt(); break;
+        case EventValue::Type::Double: mDouble = eventValue.asDouble(); break;
+        default: break;
+    }
+    mString.assign(eventValue.asString().data(), eventValue.asString().size());
+    mJson.assign(eventValue.getJson().data(), eventValue.getJson().size());
+    mEnqueueTime = std::chrono::steady_clock::now();
+}
+
+EventValue QueuedEvent::getEventValue() const {
+    switch (mType) {
+        case EventValue::Type::Bool: return EventValue::makeBool(mBool, mJson);
+        case EventValue::Type::Int: return EventValue::makeInt(mInt, mJson);
+        case EventValue::Type::Double: return EventValue::makeDouble(mDouble, mJson);
+        case EventValue::Type::String: return EventValue::makeString(mString, mJson);
+        case EventValue::Type::Array:
+        case EventValue::Type::Object: return EventValue::makeComposite(mType, mJson);
+        case EventValue::Type::Null: return EventValue();
+    }
+    return EventValue();
+}
+
+#pragma mark -
+
+EventQueue::EventQueue(size_t capacity) : mEnqueuePosition(0), mDequeuePosition(0), mDroppedCount(0) {
+    // round up to a power of two so positions wrap with a mask
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    mMask = size - 1;
+    mCells.reset(new Cell[size]);
+    for (size_t idx = 0; idx < size; idx++) {
+        mCells[idx].sequence.store(idx, std::memory_order_relaxed);
+    }
+}
+
+bool EventQueue::push(const boost::string_ref& eventName, const EventValue& eventValue) {
+    Cell* cell = nullptr;
+    size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &mCells[position & mMask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = mEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event.assign(eventName, eventValue);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+QueuedEvent* EventQueue::front() {
+    Cell* cell = &mCells[mDequeuePosition & mMask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence != mDequeuePosition + 1) {
+        return nullptr;
+    }
+    return &cell->event;
+}
+
+void EventQueue::pop() {
+    Cell* cell = &mCells[mDequeuePosition & mMask];
+    cell->sequence.store(mDequeuePosition + mMask + 1, std::memory_order_release);
+    mDequeuePosition++;
+}
+
+}}
@@ -0,0 +1,75 @@
+//
+//  EventQueue.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "EventValue.h"
+#include <atomic>
+#include <chrono>
+
+namespace Cinder { namespace Noam {
+
+// Received event copied out of its frame so it can cross threads, slots are reused and keep their string capacity
+class QueuedEvent {
+public:
+    QueuedEvent();
+
+    void assign(const boost::string_ref& eventName, const EventValue& eventValue);
+
+    inline const std::string& getEventName() const { return mEventName; }
+    // view into this slot, valid until the slot is released
+    EventValue getEventValue() const;
+    inline const std::chrono::steady_clock::time_point& getEnqueueTime() const { return mEnqueueTime; }
+
+private:
+    std::string mEventName;
+    EventValue::Type mType;
+    union {
+        bool mBool;
+        int64_t mInt;
+        double mDouble;
+    };
+    std::string mString;
+    std::string mJson;
+    std::chrono::steady_clock::time_point mEnqueueTime;
+};
+
+// Bounded lock-free queue of received events, any number of producers and a single consumer.
+//  After D. Vyukov's bounded MPMC queue, each slot carries a sequence number so producers claim slots with a single CAS.
+class EventQueue {
+public:
+    explicit EventQueue(size_t capacity);
+
+    // false when full, the event is dropped
+    bool push(const boost::string_ref& eventName, const EventValue& eventValue);
+
+    // consumer only, front() is valid until pop()
+    QueuedEvent* front();
+    void pop();
+
+    inline size_t getCapacity() const { return mMask + 1; }
+    inline uint64_t getDroppedCount() const { return mDroppedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        QueuedEvent event;
+    };
+
+    std::unique_ptr<Cell[]> mCells;
+    size_t mMask;
+    // NB - padded apart, producers and the consumer each hammer their own position
+    char mPadding0[64];
+    std::atomic<size_t> mEnqueuePosition;
+    char mPadding1[64];
+    size_t mDequeuePosition;
+    char mPadding2[64];
+    std::atomic<uint64_t> mDroppedCount;
+};
+
+}}
@@ -0,0 +1,231 @@
+//
+//  EventValue.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "EventValue.h"
+#include "JsonReader.h"
+#include "Base64.h"
+#include "cinder/Utilities.h"
+#include <cstring>
+
+namespace Cinder { namespace Noam {
+
+static const boost::string_ref sBinaryTypeKey = "~b";
+static const boost::string_ref sBinaryDataKey = "d";
+
+// reads {"~b":type,"d":data} in either order
+static bool readBinary(JsonReader& reader, boost::string_ref& elementType, boost::string_ref& data) {
+    if (!reader.expect('{')) {
+        return false;
+    }
+    do {
+        boost::string_ref key;
+        if (!reader.readString(key) || !reader.expect(':')) {
+            return false;
+        }
+        if (key == sBinaryTypeKey) {
+            if (!reader.readString(elementType)) {
+                return false;
+            }
+        } else if (key == sBinaryDataKey) {
+            if (!reader.readString(data)) {
+                return false;
+            }
+        } else if (!reader.skipValue()) {
+            return false;
+        }
+    } while (reader.consume(','));
+    return reader.expect('}') && !elementType.empty();
+}
+
+template<typename T>
+static bool decodeArray(const EventValue& value, const boost::string_ref& elementType, std::vector<T>& values) {
+    values.clear();
+    if (!value.isComposite()) {
+        return false;
+    }
+
+    JsonReader reader;
+    reader.reset(value.getJson());
+    if (value.getType() == EventValue::Type::Object) {
+        boost::string_ref type;
+        boost::string_ref data;
+        if (!readBinary(reader, type, data) || type != elementType) {
+            return false;
+        }
+
+        // NB - decoded straight into the values, elements are little endian on the wire as they are in memory
+        values.resize((Base64::getDecodedSize(data.data(), data.size()) + sizeof(T) - 1) / sizeof(T));
+        size_t size = 0;
+        if (!Base64::decode(data.data(), data.size(), reinterpret_cast<uint8_t*>(values.data()), size) || size % sizeof(T) != 0) {
+            values.clear();
+            return false;
+        }
+        values.resize(size / sizeof(T));
+        return true;
+    }
+
+    // plain JSON array fallback
+    if (!reader.expect('[')) {
+        return false;
+    }
+    if (reader.consume(']')) {
+        return true;
+    }
+    do {
+        EventValue element;
+        if (!reader.readValue(element) || !element.isNumber()) {
+            values.clear();
+            return false;
+        }
+        values.push_back(element.getType() == EventValue::Type::Int ? static_cast<T>(element.asInt()) : static_cast<T>(element.asDouble()));
+    } while (reader.consume(','));
+    return reader.expect(']');
+}
+
+EventValue::EventValue() : mType(Type::Null), mInt(0) {
+}
+
+EventValue EventValue::makeBool(bool value, const boost::string_ref& json) {
+    EventValue result;
+    result.mType = Type::Bool;
+    result.mBool = value;
+    result.mJson = json;
+    return result;
+}
+
+EventValue EventValue::makeInt(int64_t value, const boost::string_ref& json) {
+    EventValue result;
+    result.mType = Type::Int;
+    result.mInt = value;
+    result.mJson = json;
+    return result;
+}
+
+EventValue EventValue::makeDouble(double value, const boost::string_ref& json) {
+    EventValue result;
+    result.mType = Type::Double;
+    result.mDouble = value;
+    result.mJson = json;
+    return result;
+}
+
+EventValue EventValue::makeString(const boost::string_ref& value, const boost::string_ref& json) {
+    EventValue result;
+    result.mType = Type::String;
+    result.mString = value;
+    result.mJson = json;
+    return result;
+}
+
+EventValue EventValue::makeComposite(Type type, const boost::string_ref& json) {
+    EventValue result;
+    result.mType = type;
+    result.mJson = json;
+    return result;
+}
+
+#pragma mark -
+
+bool EventValue::asBool() const {
+    switch (mType) {
+        case Type::Bool: return mBool;
+        case Type::Int: return mInt != 0;
+        case Type::Double: return mDouble != 0.0;
+        default: return false;
+    }
+}
+
+int64_t EventValue::asInt() const {
+    switch (mType) {
+        case Type::Bool: return mBool ? 1 : 0;
+        case Type::Int: return mInt;
+        case Type::Double: return static_cast<int64_t>(mDouble);
+        default: return 0;
+    }
+}
+
+double EventValue::asDouble() const {
+    switch (mType) {
+        case Type::Bool: return mBool ? 1.0 : 0.0;
+        case Type::Int: return static_cast<double>(mInt);
+        case Type::Double: return mDouble;
+        default: return 0.0;
+    }
+}
+
+boost::string_ref EventValue::asString() const {
+    return mType == Type::String ? mString : boost::string_ref();
+}
+
+const JsonTree& EventValue::asJsonTree() const {
+    if (!mJsonTree) {
+        switch (mType) {
+            case Type::Array:
+            case Type::Object:
+                mJsonTree = std::make_shared<JsonTree>(std::string(mJson.data(), mJson.size()));
+                break;
+            case Type::Bool:
+                mJsonTree = std::make_shared<JsonTree>("", mBool);
+                break;
+            case Type::Int:
+                mJsonTree = std::make_shared<JsonTree>("", static_cast<int64_t>(mInt));
+                break;
+            case Type::Double:
+                mJsonTree = std::make_shared<JsonTree>("", mDouble);
+                break;
+            case Type::String:
+                mJsonTree = std::make_shared<JsonTree>("", std::string(mString.data(), mString.size()));
+                break;
+            case Type::Null:
+                mJsonTree = std::make_shared<JsonTree>();
+                break;
+        }
+    }
+    return *mJsonTree;
+}
+
+std::string EventValue::toString() const {
+    // NB - matches how JsonTree stringifies values, which handlers of the std::string signature were written against
+    switch (mType) {
+        case Type::Bool: return ci::toString(mBool);
+        case Type::Int: return ci::toString(mInt);
+        case Type::Double: return ci::toString(mDouble);
+        case Type::String: return std::string(mString.data(), mString.size());
+        case Type::Array:
+        case Type::Object: return std::string(mJson.data(), mJson.size());
+        case Type::Null: return "";
+    }
+    return "";
+}
+
+#pragma mark -
+
+bool EventValue::isBinary() const {
+    if (mType != Type::Object) {
+        return false;
+    }
+    JsonReader reader;
+    reader.reset(mJson);
+    boost::string_ref elementType;
+    boost::string_ref data;
+    return readBinary(reader, elementType, data);
+}
+
+bool EventValue::asFloats(std::vector<float>& values) const {
+    return decodeArray(*this, "f32", values);
+}
+
+bool EventValue::asInts(std::vector<int32_t>& values) const {
+    return decodeArray(*this, "i32", values);
+}
+
+bool EventValue::asBytes(std::vector<uint8_t>& values) const {
+    return decodeArray(*this, "u8", values);
+}
+
+}}
@@ -0,0 +1,75 @@
+//
+//  EventValue.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "cinder/Json.h"
+#include "boost/utility/string_ref.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Cinder { namespace Noam {
+
+using namespace ci;
+
+// Typed view of an event value as it arrived on the wire. Scalars are decoded once by the parser, strings and the raw JSON
+//  of arrays and objects are views into the received frame and only valid for the duration of the handler call.
+//  Nested values are parsed into a JsonTree on first request and shared between the handlers of an event.
+class EventValue {
+public:
+    enum class Type { Null, Bool, Int, Double, String, Array, Object };
+
+    EventValue();
+
+    static EventValue makeBool(bool value, const boost::string_ref& json);
+    static EventValue makeInt(int64_t value, const boost::string_ref& json);
+    static EventValue makeDouble(double value, const boost::string_ref& json);
+    static EventValue makeString(const boost::string_ref& value, const boost::string_ref& json);
+    static EventValue makeComposite(Type type, const boost::string_ref& json);
+
+    inline Type getType() const { return mType; }
+    inline bool isNull() const { return mType == Type::Null; }
+    inline bool isNumber() const { return mType == Type::Int || mType == Type::Double; }
+    inline bool isString() const { return mType == Type::String; }
+    inline bool isComposite() const { return mType == Type::Array || mType == Type::Object; }
+
+    // numeric accessors convert between bool, int and double, anything else yields 0
+    bool asBool() const;
+    int64_t asInt() const;
+    double asDouble() const;
+    // unescaped string contents, empty for other types
+    boost::string_ref asString() const;
+    // JSON text of the value exactly as received, e.g. to forward it without re-encoding
+    inline boost::string_ref getJson() const { return mJson; }
+    // parsed on first use for arrays and objects
+    const JsonTree& asJsonTree() const;
+
+    // stringified value as handed to the std::string handler signature, nested values as JSON
+    std::string toString() const;
+
+    // sent with the binary extension, {"~b":"f32","d":"<base64>"}
+    bool isBinary() const;
+    // bulk values sent with the binary extension or as a plain JSON array of numbers, decoded into values which keeps
+    //  its capacity between calls. false when the value is neither or its binary elements are of another type
+    bool asFloats(std::vector<float>& values) const;
+    bool asInts(std::vector<int32_t>& values) const;
+    bool asBytes(std::vector<uint8_t>& values) const;
+
+private:
+    Type mType;
+    union {
+        bool mBool;
+        int64_t mInt;
+        double mDouble;
+    };
+    boost::string_ref mString;
+    boost::string_ref mJson;
+    mutable std::shared_ptr<JsonTree> mJsonTree;
+};
+
+}}
@@ -0,0 +1,253 @@
+//
+//  Fields.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "FrameEncoder.h"
+#include "JsonReader.h"
+#include "Log.h"
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Cinder { namespace Noam {
+
+// Field table of a struct sent as a JSON object, declared with NOAM_FIELDS. Undeclared types have none
+template<typename T>
+struct FieldTable {
+    static const bool sDefined = false;
+};
+
+// NB - up to 16 fields. Expanded in steps so MSVC splits __VA_ARGS__ like everyone else
+#define NOAM_FIELDS_EXPAND(x) x
+#define NOAM_FIELDS_CONCAT(a, b) NOAM_FIELDS_CONCAT_(a, b)
+#define NOAM_FIELDS_CONCAT_(a, b) a##b
+#define NOAM_FIELDS_COUNT(...) NOAM_FIELDS_EXPAND(NOAM_FIELDS_COUNT_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define NOAM_FIELDS_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, count, ...) count
+#define NOAM_FIELDS_VISIT(field) visitor(#field, sizeof(#field) - 1, &ValueType::field);
+#define NOAM_FIELDS_EACH(...) NOAM_FIELDS_EXPAND(NOAM_FIELDS_CONCAT(NOAM_FIELDS_EACH_, NOAM_FIELDS_COUNT(__VA_ARGS__))(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_1(field) NOAM_FIELDS_VISIT(field)
+#define NOAM_FIELDS_EACH_2(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_1(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_3(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_2(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_4(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_3(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_5(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_4(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_6(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_5(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_7(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_6(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_8(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_7(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_9(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_8(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_10(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_9(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_11(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_10(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_12(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_11(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_13(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_12(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_14(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_13(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_15(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_14(__VA_ARGS__))
+#define NOAM_FIELDS_EACH_16(field, ...) NOAM_FIELDS_VISIT(field) NOAM_FIELDS_EXPAND(NOAM_FIELDS_EACH_15(__VA_ARGS__))
+
+// Declares the fields of a struct sent and received as a JSON object, at global scope with the type fully qualified, e.g.
+//  NOAM_FIELDS(ci::Vec2f, x, y). Fields may be numbers, bools, strings, vectors of floats, int32_ts or bytes and other
+//  declared structs.
+#define NOAM_FIELDS(Type, ...) \
+    namespace Cinder { namespace Noam { \
+    template<> \
+    struct FieldTable<Type> { \
+        static const bool sDefined = true; \
+        typedef Type ValueType; \
+        template<typename Visitor> \
+        static void visit(Visitor& visitor) { NOAM_FIELDS_EACH(__VA_ARGS__) } \
+    }; \
+    }}
+
+// Encodes and decodes single field values, overloaded by type.
+class FieldValue {
+public:
+    static inline void encode(FrameEncoder& encoder, bool value) { encoder.appendValue(value); }
+    static inline void encode(FrameEncoder& encoder, float value) { encoder.appendValue(value); }
+    static inline void encode(FrameEncoder& encoder, double value) { encoder.appendValue(value); }
+    static inline void encode(FrameEncoder& encoder, const std::string& value) { encoder.appendString(value); }
+    static inline void encode(FrameEncoder& encoder, const std::vector<float>& values) { encoder.appendArray(values.data(), values.size()); }
+    static inline void encode(FrameEncoder& encoder, const std::vector<int32_t>& values) { encoder.appendArray(values.data(), values.size()); }
+    static inline void encode(FrameEncoder& encoder, const std::vector<uint8_t>& values) { encoder.appendArray(values.data(), values.size()); }
+    template<typename T>
+    static inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type encode(FrameEncoder& encoder, T value) { encoder.appendValue(static_cast<int64_t>(value)); }
+    template<typename T>
+    static inline typename std::enable_if<FieldTable<T>::sDefined>::type encode(FrameEncoder& encoder, const T& value);
+
+    // numbers convert as EventValue does, anything else must match
+    static inline bool decode(JsonReader& reader, bool& value) {
+        EventValue eventValue;
+        if (!reader.readValue(eventValue)) {
+            return false;
+        }
+        value = eventValue.asBool();
+        return true;
+    }
+    static inline bool decode(JsonReader& reader, float& value) {
+        EventValue eventValue;
+        if (!reader.readValue(eventValue)) {
+            return false;
+        }
+        value = static_cast<float>(eventValue.asDouble());
+        return true;
+    }
+    static inline bool decode(JsonReader& reader, double& value) {
+        EventValue eventValue;
+        if (!reader.readValue(eventValue)) {
+            return false;
+        }
+        value = eventValue.asDouble();
+        return true;
+    }
+    static inline bool decode(JsonReader& reader, std::string& value) {
+        EventValue eventValue;
+        if (!reader.readValue(eventValue) || !eventValue.isString()) {
+            return false;
+        }
+        value.assign(eventValue.asString().data(), eventValue.asString().size());
+        return true;
+    }
+    static inline bool decode(JsonReader& reader, std::vector<float>& values) {
+        EventValue eventValue;
+        return reader.readValue(eventValue) && eventValue.asFloats(values);
+    }
+    static inline bool decode(JsonReader& reader, std::vector<int32_t>& values) {
+        EventValue eventValue;
+        return reader.readValue(eventValue) && eventValue.asInts(values);
+    }
+    static inline bool decode(JsonReader& reader, std::vector<uint8_t>& values) {
+        EventValue eventValue;
+        return reader.readValue(eventValue) && eventValue.asBytes(values);
+    }
+    template<typename T>
+    static inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool>::type decode(JsonReader& reader, T& value) {
+        EventValue eventValue;
+        if (!reader.readValue(eventValue)) {
+            return false;
+        }
+        value = static_cast<T>(eventValue.asInt());
+        return true;
+    }
+    template<typename T>
+    static inline typename std::enable_if<FieldTable<T>::sDefined, bool>::type decode(JsonReader& reader, T& value);
+};
+
+// Object encoding and decoding for a type declared with NOAM_FIELDS. The field table is expanded at compile time, keys
+//  are literals and decoding reads straight into the value without a JsonTree. Unknown keys are skipped, missing ones
+//  keep their default.
+template<typename T>
+class Fields {
+public:
+    static void encode(FrameEncoder& encoder, const T& value) {
+        Encoder fieldEncoder(encoder, value);
+        FieldTable<T>::visit(fieldEncoder);
+        if (fieldEncoder.first) {
+            encoder.appendRaw('{');
+        }
+        encoder.appendRaw('}');
+    }
+
+    // as handed to Lemma, which knows nothing of the type
+    static void encodeValue(FrameEncoder& encoder, const void* value) {
+        encode(encoder, *static_cast<const T*>(value));
+    }
+
+    static bool decode(JsonReader& reader, T& value) {
+        if (!reader.expect('{')) {
+            return false;
+        }
+        if (reader.consume('}')) {
+            return true;
+        }
+        do {
+            // NB - the key is compared before the value is read, which may reuse the reader's scratch buffer
+            boost::string_ref key;
+            if (!reader.readString(key) || !reader.expect(':')) {
+                return false;
+            }
+            Decoder fieldDecoder(reader, value, key);
+            FieldTable<T>::visit(fieldDecoder);
+            if (!fieldDecoder.matched && !reader.skipValue()) {
+                return false;
+            } else if (fieldDecoder.matched && !fieldDecoder.decoded) {
+                return false;
+            }
+        } while (reader.consume(','));
+        return reader.expect('}');
+    }
+
+    // decodes each event into a value reused between calls, events that are not such an object are logged and dropped
+    static std::function<void(const std::string&, const EventValue&)> makeHandler(const std::function<void(const std::string&, const T&)>& eventHandler) {
+        std::shared_ptr<State> state = std::make_shared<State>();
+        return [eventHandler, state](const std::string& eventName, const EventValue& eventValue) {
+            state->value = T();
+            state->reader.reset(eventValue.getJson());
+            if (!decode(state->reader, state->value)) {
+                NOAM_LOG_ERROR("event \"" << eventName << "\" is not the expected object - " << state->reader.getError());
+                return;
+            }
+            eventHandler(eventName, state->value);
+        };
+    }
+
+private:
+    struct Encoder {
+        Encoder(FrameEncoder& encoder, const T& value) : encoder(encoder), value(value), first(true) {}
+
+        template<typename M, typename C>
+        void operator()(const char* name, size_t length, M C::* member) {
+            encoder.appendRaw(first ? '{' : ',');
+            encoder.appendRaw('"');
+            encoder.appendRaw(name, length);
+            encoder.appendRaw("\":", 2);
+            FieldValue::encode(encoder, value.*member);
+            first = false;
+        }
+
+        FrameEncoder& encoder;
+        const T& value;
+        bool first;
+    };
+
+    struct Decoder {
+        Decoder(JsonReader& reader, T& value, const boost::string_ref& key) : reader(reader), value(value), key(key), matched(false), decoded(false) {}
+
+        template<typename M, typename C>
+        void operator()(const char* name, size_t length, M C::* member) {
+            if (matched || key.size() != length || std::memcmp(key.data(), name, length) != 0) {
+                return;
+            }
+            matched = true;
+            decoded = FieldValue::decode(reader, value.*member);
+        }
+
+        JsonReader& reader;
+        T& value;
+        boost::string_ref key;
+        bool matched;
+        bool decoded;
+    };
+
+    struct State {
+        JsonReader reader;
+        T value;
+    };
+};
+
+template<typename T>
+inline typename std::enable_if<FieldTable<T>::sDefined>::type FieldValue::encode(FrameEncoder& encoder, const T& value) {
+    Fields<T>::encode(encoder, value);
+}
+
+template<typename T>
+inline typename std::enable_if<FieldTable<T>::sDefined, bool>::type FieldValue::decode(JsonReader& reader, T& value) {
+    return Fields<T>::decode(reader, value);
+}
+
+}}
@@ -0,0 +1,283 @@
+//
+//  FloatFormatter.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "FloatFormatter.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Cinder { namespace Noam {
+
+// f * 2^e with a full 64 bit significand
+struct DiyFp {
+    uint64_t f;
+    int e;
+};
+
+// the value and the midpoints to its neighbours, anything strictly in between reads back as the value
+struct Boundaries {
+    DiyFp minus;
+    DiyFp w;
+    DiyFp plus;
+};
+
+// 10^k rounded to 64 bits, for k from -300 to 324 in steps of 8
+struct CachedPower {
+    uint64_t f;
+    int e;
+    int k;
+};
+
+static const CachedPower sCachedPowers[] = {
+    {0xAB70FE17C79AC6CA, -1060, -300}, {0xFF77B1FCBEBCDC4F, -1034, -292},
+    {0xBE5691EF416BD60C, -1007, -284}, {0x8DD01FAD907FFC3C, -980, -276},
+    {0xD3515C2831559A83, -954, -268}, {0x9D71AC8FADA6C9B5, -927, -260},
+    {0xEA9C227723EE8BCB, -901, -252}, {0xAECC49914078536D, -874, -244},
+    {0x823C12795DB6CE57, -847, -236}, {0xC21094364DFB5637, -821, -228},
+    {0x9096EA6F3848984F, -794, -220}, {0xD77485CB25823AC7, -768, -212},
+    {0xA086CFCD97BF97F4, -741, -204}, {0xEF340A98172AACE5, -715, -196},
+    {0xB23867FB2A35B28E, -688, -188}, {0x84C8D4DFD2C63F3B, -661, -180},
+    {0xC5DD44271AD3CDBA, -635, -172}, {0x936B9FCEBB25C996, -608, -164},
+    {0xDBAC6C247D62A584, -582, -156}, {0xA3AB66580D5FDAF6, -555, -148},
+    {0xF3E2F893DEC3F126, -529, -140}, {0xB5B5ADA8AAFF80B8, -502, -132},
+    {0x87625F056C7C4A8B, -475, -124}, {0xC9BCFF6034C13053, -449, -116},
+    {0x964E858C91BA2655, -422, -108}, {0xDFF9772470297EBD, -396, -100},
+    {0xA6DFBD9FB8E5B88F, -369, -92}, {0xF8A95FCF88747D94, -343, -84},
+    {0xB94470938FA89BCF, -316, -76}, {0x8A08F0F8BF0F156B, -289, -68},
+    {0xCDB02555653131B6, -263, -60}, {0x993FE2C6D07B7FAC, -236, -52},
+    {0xE45C10C42A2B3B06, -210, -44}, {0xAA242499697392D3, -183, -36},
+    {0xFD87B5F28300CA0E, -157, -28}, {0xBCE5086492111AEB, -130, -20},
+    {0x8CBCCC096F5088CC, -103, -12}, {0xD1B71758E219652C, -77, -4},
+    {0x9C40000000000000, -50, 4}, {0xE8D4A51000000000, -24, 12},
+    {0xAD78EBC5AC620000, 3, 20}, {0x813F3978F8940984, 30, 28},
+    {0xC097CE7BC90715B3, 56, 36}, {0x8F7E32CE7BEA5C70, 83, 44},
+    {0xD5D238A4ABE98068, 109, 52}, {0x9F4F2726179A2245, 136, 60},
+    {0xED63A231D4C4FB27, 162, 68}, {0xB0DE65388CC8ADA8, 189, 76},
+    {0x83C7088E1AAB65DB, 216, 84}, {0xC45D1DF942711D9A, 242, 92},
+    {0x924D692CA61BE758, 269, 100}, {0xDA01EE641A708DEA, 295, 108},
+    {0xA26DA3999AEF774A, 322, 116}, {0xF209787BB47D6B85, 348, 124},
+    {0xB454E4A179DD1877, 375, 132}, {0x865B86925B9BC5C2, 402, 140},
+    {0xC83553C5C8965D3D, 428, 148}, {0x952AB45CFA97A0B3, 455, 156},
+    {0xDE469FBD99A05FE3, 481, 164}, {0xA59BC234DB398C25, 508, 172},
+    {0xF6C69A72A3989F5C, 534, 180}, {0xB7DCBF5354E9BECE, 561, 188},
+    {0x88FCF317F22241E2, 588, 196}, {0xCC20CE9BD35C78A5, 614, 204},
+    {0x98165AF37B2153DF, 641, 212}, {0xE2A0B5DC971F303A, 667, 220},
+    {0xA8D9D1535CE3B396, 694, 228}, {0xFB9B7CD9A4A7443C, 720, 236},
+    {0xBB764C4CA7A44410, 747, 244}, {0x8BAB8EEFB6409C1A, 774, 252},
+    {0xD01FEF10A657842C, 800, 260}, {0x9B10A4E5E9913129, 827, 268},
+    {0xE7109BFBA19C0C9D, 853, 276}, {0xAC2820D9623BF429, 880, 284},
+    {0x80444B5E7AA7CF85, 907, 292}, {0xBF21E44003ACDD2D, 933, 300},
+    {0x8E679C2F5E44FF8F, 960, 308}, {0xD433179D9C8CB841, 986, 316},
+    {0x9E19DB92B4E31BA9, 1013, 324},
+};
+static const int sCachedPowersMinExponent = -300;
+static const int sCachedPowersStep = 8;
+
+// NB - the scaled value's exponent is kept within [alpha, gamma] so its integral part fits in 32 bits
+static const int sAlpha = -60;
+
+static inline DiyFp subtract(const DiyFp& x, const DiyFp& y) {
+    return {x.f - y.f, x.e};
+}
+
+// upper half of the 128 bit product, rounded
+static inline DiyFp multiply(const DiyFp& x, const DiyFp& y) {
+    uint64_t xLow = x.f & 0xFFFFFFFFu;
+    uint64_t xHigh = x.f >> 32;
+    uint64_t yLow = y.f & 0xFFFFFFFFu;
+    uint64_t yHigh = y.f >> 32;
+    uint64_t lowLow = xLow * yLow;
+    uint64_t lowHigh = xLow * yHigh;
+    uint64_t highLow = xHigh * yLow;
+    uint64_t highHigh = xHigh * yHigh;
+    uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu) + (uint64_t(1) << 31);
+    return {highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32), x.e + y.e + 64};
+}
+
+static inline DiyFp normalize(DiyFp x) {
+    while ((x.f >> 63) == 0) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+static inline DiyFp normalizeTo(const DiyFp& x, int e) {
+    return {x.f << (x.e - e), e};
+}
+
+// positive finite values only, Bits is the unsigned integer of the same size as T
+template <typename T, typename Bits>
+static Boundaries computeBoundaries(T value) {
+    const int precision = std::numeric_limits<T>::digits;
+    const int bias = std::numeric_limits<T>::max_exponent - 1 + (precision - 1);
+    const uint64_t hiddenBit = uint64_t(1) << (precision - 1);
+
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint64_t exponentBits = static_cast<uint64_t>(bits) >> (precision - 1);
+    uint64_t significandBits = static_cast<uint64_t>(bits) & (hiddenBit - 1);
+
+    DiyFp v = exponentBits == 0 ? DiyFp{significandBits, 1 - bias} : DiyFp{significandBits + hiddenBit, static_cast<int>(exponentBits) - bias};
+    // NB - at a power of two the next value down is half as far away as the next one up
+    bool lowerIsCloser = significandBits == 0 && exponentBits > 1;
+    DiyFp plus = {2 * v.f + 1, v.e - 1};
+    DiyFp minus = lowerIsCloser ? DiyFp{4 * v.f - 1, v.e - 2} : DiyFp{2 * v.f - 1, v.e - 1};
+
+    plus = normalize(plus);
+    return {normalizeTo(minus, plus.e), normalize(v), plus};
+}
+
+static inline CachedPower getCachedPower(int e) {
+    // NB - smallest k with 10^k * 2^e at least 2^alpha, 78913 / 2^18 being just above log10(2)
+    int f = sAlpha - e - 1;
+    int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    return sCachedPowers[(-sCachedPowersMinExponent + k + sCachedPowersStep - 1) / sCachedPowersStep];
+}
+
+// number of decimal digits in n, pow10 the largest power of 10 not above it
+static inline int countDigits(uint32_t n, uint32_t& pow10) {
+    int digits = 1;
+    pow10 = 1;
+    while (digits < 10 && n / pow10 >= 10) {
+        pow10 *= 10;
+        digits++;
+    }
+    return digits;
+}
+
+// walk the last digit down towards w while it stays within the boundaries
+static inline void roundLastDigit(char* digits, int length, uint64_t distance, uint64_t delta, uint64_t rest, uint64_t tenK) {
+    while (rest < distance && delta - rest >= tenK && (rest + tenK < distance || distance - rest > rest + tenK - distance)) {
+        digits[length - 1]--;
+        rest += tenK;
+    }
+}
+
+// as few digits of high as tell it apart from everything outside [low, high], value = digits * 10^decimalExponent
+static void generateDigits(char* digits, int& length, int& decimalExponent, const DiyFp& low, const DiyFp& w, const DiyFp& high) {
+    uint64_t delta = subtract(high, low).f;
+    uint64_t distance = subtract(high, w).f;
+
+    const DiyFp one = {uint64_t(1) << -high.e, high.e};
+    uint32_t integral = static_cast<uint32_t>(high.f >> -one.e);
+    uint64_t fractional = high.f & (one.f - 1);
+
+    uint32_t pow10 = 0;
+    int remaining = countDigits(integral, pow10);
+    while (remaining > 0) {
+        digits[length++] = static_cast<char>('0' + integral / pow10);
+        integral %= pow10;
+        remaining--;
+
+        uint64_t rest = (static_cast<uint64_t>(integral) << -one.e) + fractional;
+        if (rest <= delta) {
+            decimalExponent += remaining;
+            roundLastDigit(digits, length, distance, delta, rest, static_cast<uint64_t>(pow10) << -one.e);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    int fractionalDigits = 0;
+    do {
+        fractional *= 10;
+        digits[length++] = static_cast<char>('0' + (fractional >> -one.e));
+        fractional &= one.f - 1;
+        fractionalDigits++;
+        delta *= 10;
+        distance *= 10;
+    } while (fractional > delta);
+    decimalExponent -= fractionalDigits;
+    roundLastDigit(digits, length, distance, delta, fractional, one.f);
+}
+
+// lays out the digits in place, plain from 1e-6 up to 1e21 and in exponent notation past that
+static size_t layOut(char* output, int length, int decimalExponent) {
+    // NB - the decimal point goes after the first point digits
+    int point = length + decimalExponent;
+
+    if (length <= point && point <= 21) {
+        std::memset(output + length, '0', point - length);
+        return point;
+    }
+    if (0 < point && point <= 21) {
+        std::memmove(output + point + 1, output + point, length - point);
+        output[point] = '.';
+        return length + 1;
+    }
+    if (-6 < point && point <= 0) {
+        std::memmove(output + 2 - point, output, length);
+        output[0] = '0';
+        output[1] = '.';
+        std::memset(output + 2, '0', -point);
+        return 2 - point + length;
+    }
+
+    size_t idx = 1;
+    if (length > 1) {
+        std::memmove(output + 2, output + 1, length - 1);
+        output[1] = '.';
+        idx = length + 1;
+    }
+    int exponent = point - 1;
+    output[idx++] = 'e';
+    output[idx++] = exponent < 0 ? '-' : '+';
+    exponent = std::abs(exponent);
+    if (exponent >= 100) {
+        output[idx++] = static_cast<char>('0' + exponent / 100);
+        exponent %= 100;
+        output[idx++] = static_cast<char>('0' + exponent / 10);
+    } else if (exponent >= 10) {
+        output[idx++] = static_cast<char>('0' + exponent / 10);
+    }
+    output[idx++] = static_cast<char>('0' + exponent % 10);
+    return idx;
+}
+
+template <typename T, typename Bits>
+static size_t formatFinite(T value, char* output) {
+    size_t idx = 0;
+    if (std::signbit(value)) {
+        output[idx++] = '-';
+        value = -value;
+    }
+    if (value == 0) {
+        output[idx++] = '0';
+        return idx;
+    }
+
+    Boundaries boundaries = computeBoundaries<T, Bits>(value);
+    CachedPower cached = getCachedPower(boundaries.plus.e);
+    DiyFp power = {cached.f, cached.e};
+    DiyFp w = multiply(boundaries.w, power);
+    DiyFp minus = multiply(boundaries.minus, power);
+    DiyFp plus = multiply(boundaries.plus, power);
+    // NB - the products are off by up to a unit, stepping in by one keeps the digits within the true boundaries
+    DiyFp low = {minus.f + 1, minus.e};
+    DiyFp high = {plus.f - 1, plus.e};
+
+    int length = 0;
+    int decimalExponent = -cached.k;
+    generateDigits(output + idx, length, decimalExponent, low, w, high);
+    return idx + layOut(output + idx, length, decimalExponent);
+}
+
+#pragma mark -
+
+size_t FloatFormatter::format(double value, char* output) {
+    return formatFinite<double, uint64_t>(value, output);
+}
+
+size_t FloatFormatter::format(float value, char* output) {
+    return formatFinite<float, uint32_t>(value, output);
+}
+
+}}
@@ -0,0 +1,29 @@
+//
+//  FloatFormatter.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace Cinder { namespace Noam {
+
+// Decimal that reads back as exactly the same value, Grisu2 after Loitsch's "Printing Floating-Point Numbers Quickly and
+//  Accurately with Integers". The shortest such decimal bar a digit in rare cases, e.g. 9.999999999999999e+22 for 1e23.
+//  Unlike printf it never consults the locale. Laid out as JavaScript would, e.g. 0.1, 42, 1e-7 or 1e+21, floats read
+//  back as the same float but not necessarily the same double.
+class FloatFormatter {
+public:
+    // longest output including the sign, nothing is terminated
+    static const size_t sMaxLength = 32;
+
+    // finite values only, returns the number of characters written
+    static size_t format(double value, char* output);
+    static size_t format(float value, char* output);
+};
+
+}}
@@ -0,0 +1,158 @@
+//
+//  FrameDecoder.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "FrameDecoder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Cinder { namespace Noam {
+
+const size_t FrameDecoder::sPrefixLength;
+const size_t FrameDecoder::sMaxFrameLength;
+
+FrameDecoder::FrameDecoder(size_t initialCapacity) : mBuffer(std::max(initialCapacity, sPrefixLength)), mHead(0), mTail(0), mInput(nullptr), mInputSize(0), mInputOffset(0) {
+}
+
+#pragma mark -
+
+void FrameDecoder::feed(const char* data, size_t size) {
+    // NB - anything left of a previous read was already carried over when next() ran dry
+    mInput = data;
+    mInputSize = size;
+    mInputOffset = 0;
+}
+
+FrameDecoder::Status FrameDecoder::next(boost::string_ref& frame) {
+    if (!mError.empty()) {
+        return Status::Error;
+    }
+
+    size_t remaining = mInputSize - mInputOffset;
+
+    // finish a frame carried over from a previous read
+    if (mTail > mHead) {
+        size_t buffered = mTail - mHead;
+        if (buffered < sPrefixLength) {
+            size_t count = std::min(sPrefixLength - buffered, remaining);
+            append(mInput + mInputOffset, count);
+            mInputOffset += count;
+            remaining -= count;
+            buffered += count;
+            if (buffered < sPrefixLength) {
+                return Status::NeedMoreData;
+            }
+        }
+
+        size_t length = 0;
+        if (!parsePrefix(&mBuffer[mHead], length)) {
+            return Status::Error;
+        }
+
+        size_t total = sPrefixLength + length;
+        if (buffered < total) {
+            size_t count = std::min(total - buffered, remaining);
+            append(mInput + mInputOffset, count);
+            mInputOffset += count;
+            buffered += count;
+            if (buffered < total) {
+                return Status::NeedMoreData;
+            }
+        }
+
+        frame = boost::string_ref(&mBuffer[mHead + sPrefixLength], length);
+        mHead += total;
+        if (mHead == mTail) {
+            // NB - the view stays valid as nothing is written until the next call
+            mHead = mTail = 0;
+        }
+        return Status::Frame;
+    }
+
+    // whole frames straight out of the read
+    if (remaining == 0) {
+        return Status::NeedMoreData;
+    }
+    const char* data = mInput + mInputOffset;
+    if (remaining < sPrefixLength) {
+        append(data, remaining);
+        mInputOffset = mInputSize;
+        return Status::NeedMoreData;
+    }
+
+    size_t length = 0;
+    if (!parsePrefix(data, length)) {
+        return Status::Error;
+    }
+    if (remaining < sPrefixLength + length) {
+        append(data, remaining);
+        mInputOffset = mInputSize;
+        return Status::NeedMoreData;
+    }
+
+    frame = boost::string_ref(data + sPrefixLength, length);
+    mInputOffset += sPrefixLength + length;
+    return Status::Frame;
+}
+
+char* FrameDecoder::prepare(size_t size) {
+    // NB - whole frames already handed out were consumed, the buffer only ever holds a partial one here
+    reserve(size);
+    return &mBuffer[mTail];
+}
+
+void FrameDecoder::reset() {
+    mHead = mTail = 0;
+    mInput = nullptr;
+    mInputSize = mInputOffset = 0;
+    mError.clear();
+}
+
+#pragma mark -
+
+bool FrameDecoder::parsePrefix(const char* data, size_t& length) {
+    length = 0;
+    for (size_t idx = 0; idx < sPrefixLength; idx++) {
+        char c = data[idx];
+        if (c < '0' || c > '9') {
+            mError = "invalid message length prefix \"" + std::string(data, sPrefixLength) + "\"";
+            return false;
+        }
+        length = length * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+void FrameDecoder::reserve(size_t size) {
+    if (mTail + size <= mBuffer.size()) {
+        return;
+    }
+
+    // wrap the live bytes back around to the front, at most one partial frame
+    size_t buffered = mTail - mHead;
+    if (mHead > 0) {
+        std::memmove(&mBuffer[0], &mBuffer[mHead], buffered);
+        mHead = 0;
+        mTail = buffered;
+    }
+    // grow for an unusually large frame, bounded by the prefix to roughly 1 MB
+    if (mTail + size > mBuffer.size()) {
+        mBuffer.resize(std::max(mBuffer.size() * 2, mTail + size));
+    }
+}
+
+void FrameDecoder::append(const char* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    reserve(size);
+    std::memcpy(&mBuffer[mTail], data, size);
+    mTail += size;
+}
+
+}}
@@ -0,0 +1,65 @@
+//
+//  FrameDecoder.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "boost/utility/string_ref.hpp"
+
+namespace Cinder { namespace Noam {
+
+// Incremental decoder for the Noam TCP framing, a 6 digit zero-padded ASCII length prefix followed by that many bytes of JSON.
+//  Reads can split a frame anywhere, including inside the prefix, so bytes that do not yet form a whole frame are carried
+//  over in a persistent buffer. Whole frames are handed out as views, directly into the fed data when possible and into
+//  the carry buffer otherwise; nothing is copied per frame.
+class FrameDecoder {
+public:
+    enum class Status { Frame, NeedMoreData, Error };
+
+    static const size_t sPrefixLength = 6;
+    static const size_t sMaxFrameLength = 999999;
+
+    explicit FrameDecoder(size_t initialCapacity = 64 * 1024);
+
+    // Hand the decoder the bytes from one read, they must remain valid until next() returns NeedMoreData
+    void feed(const char* data, size_t size);
+    // Extract the next whole frame, the view is valid until the following call to next() or feed()
+    Status next(boost::string_ref& frame);
+
+    // Space for a read straight into the carry buffer rather than feeding it, at least size bytes. Valid until commit()
+    char* prepare(size_t size);
+    // Account for the bytes read into prepare()'s space, whole frames then come out of next() as views into the buffer
+    inline void commit(size_t size) { mTail += size; }
+
+    // Drop carried and fed bytes, e.g. after an error or when the session is torn down
+    void reset();
+
+    inline const std::string& getError() const { return mError; }
+    inline size_t getBufferedSize() const { return mTail - mHead; }
+    inline size_t getCapacity() const { return mBuffer.size(); }
+
+private:
+    bool parsePrefix(const char* data, size_t& length);
+    void reserve(size_t size);
+    void append(const char* data, size_t size);
+
+    // carry buffer, live bytes are [mHead, mTail)
+    std::vector<char> mBuffer;
+    size_t mHead;
+    size_t mTail;
+
+    // current read, unconsumed bytes are [mInput + mInputOffset, mInput + mInputSize)
+    const char* mInput;
+    size_t mInputSize;
+    size_t mInputOffset;
+
+    std::string mError;
+};
+
+}}
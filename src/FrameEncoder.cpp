@@ -0,0 +1,207 @@
+//
+//  FrameEncoder.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "FrameEncoder.h"
+#include "FrameDecoder.h"
+#include "Base64.h"
+#include "FloatFormatter.h"
+#include "JsonScanner.h"
+#include <cmath>
+#include <cstdio>
+
+namespace Cinder { namespace Noam {
+
+static const char sHexDigits[] = "0123456789abcdef";
+static const char sEventFrameHeader[] = "[\"event\",";
+static const char sBinaryTypeKey[] = "{\"~b\":\"";
+static const char sBinaryDataKey[] = "\",\"d\":\"";
+
+FrameEncoder::FrameEncoder(size_t initialCapacity) : mFrameOffset(0) {
+    mData.reserve(initialCapacity);
+}
+
+std::string FrameEncoder::quote(const std::string& value) {
+    FrameEncoder encoder(value.size() + 2);
+    encoder.appendString(value);
+    return std::string(encoder.getData(), encoder.getSize());
+}
+
+#pragma mark -
+
+void FrameEncoder::clear() {
+    // NB - keeps the capacity, steady state encoding does not allocate
+    mData.clear();
+    mFrameOffset = 0;
+}
+
+void FrameEncoder::beginFrame() {
+    mFrameOffset = mData.size();
+    mData.resize(mFrameOffset + FrameDecoder::sPrefixLength, '0');
+}
+
+bool FrameEncoder::endFrame() {
+    size_t length = mData.size() - mFrameOffset - FrameDecoder::sPrefixLength;
+    if (length > FrameDecoder::sMaxFrameLength) {
+        mData.resize(mFrameOffset);
+        return false;
+    }
+
+    char* prefix = &mData[mFrameOffset];
+    for (size_t idx = FrameDecoder::sPrefixLength; idx > 0; idx--) {
+        prefix[idx - 1] = static_cast<char>('0' + length % 10);
+        length /= 10;
+    }
+    return true;
+}
+
+void FrameEncoder::beginEventFrame(const std::string& quotedGuestName, const std::string& eventName) {
+    beginFrame();
+    appendRaw(sEventFrameHeader, sizeof(sEventFrameHeader) - 1);
+    appendRaw(quotedGuestName);
+    appendRaw(',');
+    appendString(eventName);
+    appendRaw(',');
+}
+
+void FrameEncoder::endEventFrame() {
+    appendRaw(']');
+}
+
+#pragma mark -
+
+void FrameEncoder::appendRaw(const char* data, size_t size) {
+    mData.insert(mData.end(), data, data + size);
+}
+
+void FrameEncoder::appendString(const char* data, size_t size) {
+    mData.push_back('"');
+    size_t start = 0;
+    // NB - plain runs between escapes are found and copied in bulk
+    for (size_t idx = JsonScanner::findSpecial(data, size); idx < size; idx = start + JsonScanner::findSpecial(data + start, size - start)) {
+        unsigned char c = static_cast<unsigned char>(data[idx]);
+        appendRaw(data + start, idx - start);
+        start = idx + 1;
+        mData.push_back('\\');
+        switch (c) {
+            case '"': mData.push_back('"'); break;
+            case '\\': mData.push_back('\\'); break;
+            case '\b': mData.push_back('b'); break;
+            case '\f': mData.push_back('f'); break;
+            case '\n': mData.push_back('n'); break;
+            case '\r': mData.push_back('r'); break;
+            case '\t': mData.push_back('t'); break;
+            default: {
+                const char escape[] = {'u', '0', '0', sHexDigits[c >> 4], sHexDigits[c & 0xF]};
+                appendRaw(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    appendRaw(data + start, size - start);
+    mData.push_back('"');
+}
+
+void FrameEncoder::appendValue(bool value) {
+    if (value) {
+        appendRaw("true", 4);
+    } else {
+        appendRaw("false", 5);
+    }
+}
+
+void FrameEncoder::appendValue(int value) {
+    appendValue(static_cast<int64_t>(value));
+}
+
+void FrameEncoder::appendValue(int64_t value) {
+    char buffer[24];
+    int length = std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+    appendRaw(buffer, static_cast<size_t>(length));
+}
+
+void FrameEncoder::appendValue(float value) {
+    // NB - JSON has no representation for NaN or infinity
+    if (!std::isfinite(value)) {
+        appendRaw("null", 4);
+        return;
+    }
+    // NB - printf would follow the locale, e.g. "0,5" under de_DE
+    char buffer[FloatFormatter::sMaxLength];
+    appendRaw(buffer, FloatFormatter::format(value, buffer));
+}
+
+void FrameEncoder::appendValue(double value) {
+    if (!std::isfinite(value)) {
+        appendRaw("null", 4);
+        return;
+    }
+    char buffer[FloatFormatter::sMaxLength];
+    appendRaw(buffer, FloatFormatter::format(value, buffer));
+}
+
+void FrameEncoder::appendValue(const EventValue& value) {
+    if (!value.getJson().empty()) {
+        appendRaw(value.getJson().data(), value.getJson().size());
+        return;
+    }
+    switch (value.getType()) {
+        case EventValue::Type::Bool: appendValue(value.asBool()); break;
+        case EventValue::Type::Int: appendValue(value.asInt()); break;
+        case EventValue::Type::Double: appendValue(value.asDouble()); break;
+        case EventValue::Type::String: appendString(value.asString().data(), value.asString().size()); break;
+        default: appendRaw("null", 4); break;
+    }
+}
+
+#pragma mark -
+
+void FrameEncoder::appendArray(const float* values, size_t count) {
+    appendRaw('[');
+    for (size_t idx = 0; idx < count; idx++) {
+        if (idx) {
+            appendRaw(',');
+        }
+        appendValue(values[idx]);
+    }
+    appendRaw(']');
+}
+
+void FrameEncoder::appendArray(const int32_t* values, size_t count) {
+    appendRaw('[');
+    for (size_t idx = 0; idx < count; idx++) {
+        if (idx) {
+            appendRaw(',');
+        }
+        appendValue(static_cast<int64_t>(values[idx]));
+    }
+    appendRaw(']');
+}
+
+void FrameEncoder::appendArray(const uint8_t* values, size_t count) {
+    appendRaw('[');
+    for (size_t idx = 0; idx < count; idx++) {
+        if (idx) {
+            appendRaw(',');
+        }
+        appendValue(static_cast<int64_t>(values[idx]));
+    }
+    appendRaw(']');
+}
+
+void FrameEncoder::appendBinary(const char* elementType, const void* data, size_t size) {
+    // NB - elements are copied as they are in memory, little endian on every platform Cinder targets
+    appendRaw(sBinaryTypeKey, sizeof(sBinaryTypeKey) - 1);
+    appendRaw(elementType, std::strlen(elementType));
+    appendRaw(sBinaryDataKey, sizeof(sBinaryDataKey) - 1);
+    size_t offset = mData.size();
+    mData.resize(offset + Base64::getEncodedSize(size));
+    Base64::encode(static_cast<const uint8_t*>(data), size, &mData[offset]);
+    appendRaw("\"}", 2);
+}
+
+}}
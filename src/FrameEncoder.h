@@ -0,0 +1,80 @@
+//
+//  FrameEncoder.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "EventValue.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+namespace Cinder { namespace Noam {
+
+// Writes length prefixed Noam frames straight into a reusable buffer, no intermediate JsonTree or strings.
+//  Frames accumulate until clear(), so several can be encoded back to back and written at once.
+class FrameEncoder {
+public:
+    explicit FrameEncoder(size_t initialCapacity = 4 * 1024);
+
+    // JSON string literal, quotes included, for values that are written over and over like the guest name
+    static std::string quote(const std::string& value);
+
+    void clear();
+
+    // reserve the length prefix, frames do not nest
+    void beginFrame();
+    // patch the length prefix, returns false and discards the frame if it exceeds the prefix
+    bool endFrame();
+    // drop the frame most recently begun, ended or not
+    inline void discardFrame() { mData.resize(mFrameOffset); }
+
+    // opens ["event", guest, name, — the caller appends the value and ends the frame
+    void beginEventFrame(const std::string& quotedGuestName, const std::string& eventName);
+    void endEventFrame();
+
+    void appendRaw(const char* data, size_t size);
+    inline void appendRaw(const std::string& value) { appendRaw(value.data(), value.size()); }
+    inline void appendRaw(char c) { mData.push_back(c); }
+    void appendString(const char* data, size_t size);
+    inline void appendString(const std::string& value) { appendString(value.data(), value.size()); }
+
+    void appendValue(bool value);
+    void appendValue(int value);
+    void appendValue(int64_t value);
+    void appendValue(float value);
+    void appendValue(double value);
+    inline void appendValue(const std::string& value) { appendString(value); }
+    inline void appendValue(const char* value) { appendString(value, std::strlen(value)); }
+    // the JSON as received when there is one, values made in process are encoded by type
+    void appendValue(const EventValue& value);
+
+    // bulk values as a plain JSON array
+    void appendArray(const float* values, size_t count);
+    void appendArray(const int32_t* values, size_t count);
+    void appendArray(const uint8_t* values, size_t count);
+    // bulk values as {"~b":"f32","d":"<base64>"}, the binary extension, elements little endian
+    inline void appendBinary(const float* values, size_t count) { appendBinary("f32", values, count * sizeof(float)); }
+    inline void appendBinary(const int32_t* values, size_t count) { appendBinary("i32", values, count * sizeof(int32_t)); }
+    inline void appendBinary(const uint8_t* values, size_t count) { appendBinary("u8", values, count); }
+
+    inline const char* getData() const { return mData.data(); }
+    inline char* getData() { return mData.data(); }
+    inline size_t getSize() const { return mData.size(); }
+    inline bool isEmpty() const { return mData.empty(); }
+    // start of the frame most recently begun
+    inline size_t getFrameOffset() const { return mFrameOffset; }
+
+private:
+    void appendBinary(const char* elementType, const void* data, size_t size);
+
+    std::vector<char> mData;
+    size_t mFrameOffset;
+};
+
+}}
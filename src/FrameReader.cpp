@@ -0,0 +1,96 @@
+//
+//  FrameReader.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "FrameReader.h"
+
+namespace Cinder { namespace Noam {
+
+FrameReaderRef FrameReader::create(size_t readSize) {
+    return FrameReaderRef(new FrameReader(readSize));
+}
+
+FrameReader::FrameReader(size_t readSize) : mGeneration(0), mReadSize(readSize) {
+}
+
+#pragma mark -
+
+void FrameReader::open(const TcpSocketRef& socket) {
+    close();
+
+    mSocket = socket;
+    read();
+}
+
+void FrameReader::close() {
+    mSocket = nullptr;
+    mGeneration++;
+    mDecoder.reset();
+}
+
+#pragma mark -
+
+void FrameReader::read() {
+    FrameReaderRef reader = shared_from_this();
+    size_t generation = mGeneration;
+    mSocket->async_read_some(boost::asio::buffer(mDecoder.prepare(mReadSize), mReadSize), makeAllocatingHandler(mHandlerMemory, [reader, generation](const boost::system::error_code& err, size_t bytesTransferred) {
+        reader->onRead(generation, err, bytesTransferred);
+    }));
+}
+
+void FrameReader::onRead(size_t generation, const boost::system::error_code& err, size_t bytesTransferred) {
+    if (generation != mGeneration) {
+        // closed while in flight, the bytes went into a buffer that has since started over
+        return;
+    }
+
+    if (err == boost::asio::error::eof) {
+        mSocket = nullptr;
+        if (mReadCompleteEventHandler) {
+            mReadCompleteEventHandler();
+        }
+        return;
+    } else if (err) {
+        mSocket = nullptr;
+        if (mErrorEventHandler) {
+            mErrorEventHandler(err.message(), bytesTransferred);
+        }
+        return;
+    }
+
+    mDecoder.commit(bytesTransferred);
+    mStats.reads++;
+    mStats.bytes += bytesTransferred;
+    if (mReadEventHandler) {
+        mReadEventHandler(bytesTransferred);
+    }
+
+    // NB - any handler may close the reader, or close and reopen it, either way these frames are done with
+    boost::string_ref frame;
+    FrameDecoder::Status status;
+    while ((status = mDecoder.next(frame)) == FrameDecoder::Status::Frame) {
+        mStats.frames++;
+        if (mFrameEventHandler) {
+            mFrameEventHandler(frame);
+        }
+        if (generation != mGeneration) {
+            return;
+        }
+    }
+    if (status == FrameDecoder::Status::Error) {
+        std::string error = mDecoder.getError();
+        close();
+        if (mFrameErrorEventHandler) {
+            mFrameErrorEventHandler(error);
+        }
+        return;
+    }
+
+    read();
+}
+
+}}
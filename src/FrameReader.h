@@ -0,0 +1,75 @@
+//
+//  FrameReader.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "TcpSession.h"
+#include "FrameDecoder.h"
+#include "HandlerMemory.h"
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class FrameReader> FrameReaderRef;
+
+// Inbound frames for a TCP session. Reads land straight in the decoder's carry buffer rather than in a buffer per read,
+//  whole frames are handed to the frame handler as views into it and the buffer starts over once they are consumed, so
+//  steady state reads do not allocate. One read is in flight at a time, only open, close and read on the io_service.
+class FrameReader : public std::enable_shared_from_this<FrameReader> {
+public:
+    struct Stats {
+        Stats() : reads(0), bytes(0), frames(0) {}
+
+        uint64_t reads;
+        uint64_t bytes;
+        uint64_t frames;
+    };
+
+    // reads ask for at least this many bytes of buffer space
+    static FrameReaderRef create(size_t readSize = 16 * 1024);
+
+    // starts reading
+    void open(const TcpSocketRef& socket);
+    // a read in flight completes unseen, partial frames are dropped
+    void close();
+
+    inline bool isOpen() const { return static_cast<bool>(mSocket); }
+    inline const Stats& getStats() const { return mStats; }
+    // operations that could not use the reader's handler memory
+    inline uint64_t getHandlerAllocationCount() const { return mHandlerMemory.getFallbackCount(); }
+
+    // after each read, before its frames
+    void connectReadEventHandler(const std::function<void(size_t)>& eventHandler) { mReadEventHandler = eventHandler; }
+    // the frame is only valid for the duration of the call, which may close() the reader
+    void connectFrameEventHandler(const std::function<void(const boost::string_ref&)>& eventHandler) { mFrameEventHandler = eventHandler; }
+    // the stream can no longer be framed, reading stops
+    void connectFrameErrorEventHandler(const std::function<void(const std::string&)>& eventHandler) { mFrameErrorEventHandler = eventHandler; }
+    // the peer closed the connection
+    void connectReadCompleteEventHandler(const std::function<void()>& eventHandler) { mReadCompleteEventHandler = eventHandler; }
+    void connectErrorEventHandler(const std::function<void(std::string, size_t)>& eventHandler) { mErrorEventHandler = eventHandler; }
+
+private:
+    FrameReader(size_t readSize);
+
+    void read();
+    void onRead(size_t generation, const boost::system::error_code& err, size_t bytesTransferred);
+
+    TcpSocketRef mSocket;
+    size_t mGeneration;
+    size_t mReadSize;
+    FrameDecoder mDecoder;
+    HandlerMemory mHandlerMemory;
+    Stats mStats;
+
+    std::function<void(size_t)> mReadEventHandler;
+    std::function<void(const boost::string_ref&)> mFrameEventHandler;
+    std::function<void(const std::string&)> mFrameErrorEventHandler;
+    std::function<void()> mReadCompleteEventHandler;
+    std::function<void(std::string, size_t)> mErrorEventHandler;
+};
+
+}}
@@ -0,0 +1,79 @@
+//
+//  HandlerMemory.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Cinder { namespace Noam {
+
+// Storage for the handler of one pending asynchronous operation, asio allocates the operation from it rather than the
+//  heap. Larger operations, or a second one while the first is pending, fall back to the heap and are counted. After
+//  the allocation example that ships with asio. Owned by whatever the handler keeps alive, e.g. the queue it captures.
+class HandlerMemory {
+public:
+    HandlerMemory() : mInUse(false), mFallbackCount(0) {}
+
+    void* allocate(size_t size) {
+        bool inUse = false;
+        if (size <= sizeof(mStorage) && mInUse.compare_exchange_strong(inUse, true)) {
+            return &mStorage;
+        }
+        mFallbackCount.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    void deallocate(void* pointer) {
+        if (pointer == &mStorage) {
+            mInUse.store(false);
+            return;
+        }
+        ::operator delete(pointer);
+    }
+
+    // operations that went to the heap
+    inline uint64_t getFallbackCount() const { return mFallbackCount.load(std::memory_order_relaxed); }
+
+private:
+    HandlerMemory(const HandlerMemory&);
+    HandlerMemory& operator=(const HandlerMemory&);
+
+    // NB - room for a gathered write, its operation keeps the buffer sequence and comes to nearly 500 bytes
+    std::aligned_storage<1024>::type mStorage;
+    std::atomic<bool> mInUse;
+    std::atomic<uint64_t> mFallbackCount;
+};
+
+// Wraps a completion handler so asio allocates its operation from the memory, found by asio through the hooks below.
+template<typename Handler>
+class AllocatingHandler {
+public:
+    AllocatingHandler(HandlerMemory& memory, const Handler& handler) : mMemory(&memory), mHandler(handler) {}
+
+    template<typename... Args>
+    void operator()(Args&&... args) { mHandler(std::forward<Args>(args)...); }
+
+    friend void* asio_handler_allocate(size_t size, AllocatingHandler* handler) { return handler->mMemory->allocate(size); }
+    friend void asio_handler_deallocate(void* pointer, size_t, AllocatingHandler* handler) { handler->mMemory->deallocate(pointer); }
+
+private:
+    HandlerMemory* mMemory;
+    Handler mHandler;
+};
+
+template<typename Handler>
+inline AllocatingHandler<Handler> makeAllocatingHandler(HandlerMemory& memory, const Handler& handler) {
+    return AllocatingHandler<Handler>(memory, handler);
+}
+
+}}
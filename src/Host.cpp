@@ -0,0 +1,436 @@
+//
+//  Host.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Host.h"
+#include "Log.h"
+#include "cinder/app/App.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+using namespace ci;
+
+static const uint16_t sAvailabilityBroadcastPort = 1030;
+static const std::string sAvailabilityBroadcastHeader = "marco";
+static const std::string sAvailabilityBroadcastResponseHeader = "polo";
+
+static const std::string sHeartbeatHeader = "heartbeat";
+static const std::string sHeartbeatAckHeader = "heartbeat_ack";
+static const std::string sCompressionHeader = "compression";
+
+// forwarded frames shorter than this are not worth compressing
+static const size_t sCompressionThreshold = 512;
+
+// beyond this a subscriber is considered stuck and frames to it are dropped rather than buffered
+static const size_t sMaxPendingBytes = 4 * 1024 * 1024;
+
+const uint16_t Host::sDefaultPort;
+
+HostRef Host::create(const std::string& roomName, uint16_t port) {
+    return create(ci::app::App::get()->io_service(), roomName, port);
+}
+
+HostRef Host::create(boost::asio::io_service& io, const std::string& roomName, uint16_t port) {
+    return HostRef(new Host(io, roomName, port))->shared_from_this();
+}
+
+Host::Host(boost::asio::io_service& io, const std::string& roomName, uint16_t port) : mRoomName(roomName), mPort(port), mRunning(false), mIoService(&io) {
+}
+
+Host::~Host() {
+    end();
+
+    mUDPServer = nullptr;
+    mUDPServerSession = nullptr;
+    mTCPServer = nullptr;
+}
+
+#pragma mark -
+
+void Host::begin() {
+    if (mRunning) {
+        return;
+    }
+    mRunning = true;
+
+    setupDiscoveryServer();
+    setupMessagingServer();
+}
+
+void Host::end() {
+    if (!mRunning) {
+        return;
+    }
+    mRunning = false;
+
+    if (mUDPServerSession && mUDPServerSession->getSocket()->is_open()) {
+        boost::system::error_code err;
+        mUDPServerSession->getSocket()->close(err);
+        if (err) {
+            NOAM_LOG_ERROR("host UDP server session failed to close - " << err);
+        }
+    }
+    if (mTCPServer) {
+        mTCPServer->cancel();
+    }
+
+    while (!mGuests.empty()) {
+        removeGuest(mGuests.front());
+    }
+}
+
+LoopbackHubRef Host::getLoopbackHub() {
+    if (mLoopbackHub) {
+        return mLoopbackHub;
+    }
+
+    mLoopbackHub = LoopbackHub::create();
+    std::weak_ptr<Host> weakHost = shared_from_this();
+    boost::asio::io_service& io = getIoService();
+    mLoopbackHub->connectBridgeEventHandler([weakHost, &io](const boost::string_ref& guestName, const boost::string_ref& eventName, const EventValue& eventValue) {
+        // NB - called on the sending lemma's thread, the frame is encoded there and routed on the host's
+        FrameEncoder encoder(FrameDecoder::sPrefixLength + guestName.size() + eventName.size() + eventValue.getJson().size() + 32);
+        encoder.beginEventFrame(FrameEncoder::quote(std::string(guestName.data(), guestName.size())), std::string(eventName.data(), eventName.size()));
+        encoder.appendValue(eventValue);
+        encoder.endEventFrame();
+        if (!encoder.endFrame()) {
+            return;
+        }
+        std::shared_ptr<std::string> frame = std::make_shared<std::string>(encoder.getData() + FrameDecoder::sPrefixLength, encoder.getSize() - FrameDecoder::sPrefixLength);
+        std::shared_ptr<std::string> name = std::make_shared<std::string>(eventName.data(), eventName.size());
+        io.post([weakHost, frame, name]() {
+            if (HostRef host = weakHost.lock()) {
+                host->mStats.events++;
+                host->routeEvent(*frame, boost::string_ref(), *name);
+            }
+        });
+    });
+    return mLoopbackHub;
+}
+
+#pragma mark - DISCOVERY
+
+void Host::setupDiscoveryServer() {
+    mUDPServer = UdpServer::create(getIoService());
+    mUDPServer->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("host UDP server - " << err);
+    });
+    mUDPServer->connectAcceptEventHandler([&](UdpSessionRef session) {
+        mUDPServerSession = session;
+        mUDPServerSession->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+            NOAM_LOG_ERROR("host UDP server session - " << err);
+        });
+        mUDPServerSession->connectReadEventHandler([&](ci::Buffer buffer) {
+            boost::asio::ip::udp::endpoint endpoint = mUDPServerSession->getRemoteEndpoint();
+            std::string request = UdpSession::bufferToString(buffer);
+
+            // ["marco", guestName, roomName, dialect, version]
+            JsonReader reader;
+            reader.reset(request);
+            boost::string_ref header;
+            boost::string_ref guestName;
+            boost::string_ref roomName;
+            if (!reader.expect('[') || !reader.readString(header) || header != sAvailabilityBroadcastHeader || !reader.expect(',') || !reader.readString(guestName) || !reader.expect(',') || !reader.readString(roomName)) {
+                NOAM_LOG_ERROR("host received a bad availability broadcast - " << request);
+            } else if (roomName.empty() || roomName == mRoomName) {
+                JsonTree rootArray = JsonTree::makeArray();
+                rootArray.pushBack(JsonTree("", sAvailabilityBroadcastResponseHeader));
+                rootArray.pushBack(JsonTree("", mRoomName));
+                rootArray.pushBack(JsonTree("", mPort));
+                std::shared_ptr<std::string> response = std::make_shared<std::string>(rootArray.serialize());
+
+                // NB - answer the sender directly, the session socket is not connected to it
+                mUDPServerSession->getSocket()->async_send_to(boost::asio::buffer(*response), endpoint, [response](const boost::system::error_code& err, size_t bytesTransferred) {
+                    if (err) {
+                        NOAM_LOG_ERROR("host failed to answer availability broadcast - " << err.message());
+                    }
+                });
+            }
+
+            mUDPServerSession->read();
+        });
+
+        mUDPServerSession->read();
+    });
+
+    mUDPServer->accept(sAvailabilityBroadcastPort);
+    NOAM_LOG_NOTICE("host UDP server listening on port " << sAvailabilityBroadcastPort);
+}
+
+#pragma mark - MESSAGING
+
+void Host::setupMessagingServer() {
+    mTCPServer = TcpServer::create(getIoService());
+    mTCPServer->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("host TCP server - " << err);
+    });
+    mTCPServer->connectCancelEventHandler([]() {
+        NOAM_LOG_NOTICE("host TCP server canceled");
+    });
+    mTCPServer->connectAcceptEventHandler([&](TcpSessionRef session) {
+        GuestRef guest = std::make_shared<Guest>();
+        guest->inbound = session;
+        mGuests.push_back(guest);
+
+        // NB - handlers hold the guest weakly, it is owned by the host and may be gone by the time they fire
+        std::weak_ptr<Guest> weakGuest = guest;
+        session->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+            NOAM_LOG_ERROR("host TCP server session - " << err);
+        });
+        // NB - read straight into the guest's frame reader rather than through the session
+        guest->reader = FrameReader::create();
+        guest->reader->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+            NOAM_LOG_ERROR("host TCP server session read - " << err);
+        });
+        guest->reader->connectFrameEventHandler([&, weakGuest](const boost::string_ref& frame) {
+            if (GuestRef guest = weakGuest.lock()) {
+                handleMessage(guest, frame);
+            }
+        });
+        guest->reader->connectFrameErrorEventHandler([&, weakGuest](const std::string& err) {
+            if (GuestRef guest = weakGuest.lock()) {
+                NOAM_LOG_ERROR("host dropping guest \"" << guest->name << "\" - " << err);
+                removeGuest(guest);
+            }
+        });
+        guest->reader->connectReadCompleteEventHandler([&, weakGuest]() {
+            if (GuestRef guest = weakGuest.lock()) {
+                NOAM_LOG_NOTICE("host guest \"" << guest->name << "\" disconnected");
+                removeGuest(guest);
+            }
+        });
+        guest->reader->open(session->getSocket());
+
+        // NB - the server accepts a single connection per call, wait for the next guest
+        if (mRunning) {
+            mTCPServer->accept(mPort);
+        }
+    });
+
+    mTCPServer->accept(mPort);
+    NOAM_LOG_NOTICE("host TCP server listening on port " << mPort);
+}
+
+void Host::handleMessage(const GuestRef& guest, const boost::string_ref& receivedFrame) {
+    boost::string_ref frame = receivedFrame;
+    boost::string_ref compressedFrame;
+    if (!frame.empty() && frame[0] == Compressor::sFrameMarker) {
+        if (!mDecompressor.decompress(frame.data() + 1, frame.size() - 1)) {
+            NOAM_LOG_ERROR("host failed to decompress message from guest \"" << guest->name << "\"");
+            return;
+        }
+        compressedFrame = frame;
+        frame = boost::string_ref(mDecompressor.getData(), mDecompressor.getSize());
+    }
+
+    if (!mMessageParser.parse(frame)) {
+        NOAM_LOG_ERROR("host failed to parse message - " << mMessageParser.getError());
+        return;
+    }
+
+    if (mMessageParser.isEvent()) {
+        if (!guest->registered) {
+            NOAM_LOG_ERROR("host received an event from an unregistered guest");
+            return;
+        }
+        mStats.events++;
+        routeEvent(frame, compressedFrame, mMessageParser.getEventName());
+        if (mLoopbackHub) {
+            mLoopbackHub->deliver(mMessageParser.getEventName(), mMessageParser.getEventValue());
+        }
+    } else if (mMessageParser.isRegistration()) {
+        // NB - the guest may have hung up since, it is then gone before it was ever registered
+        boost::system::error_code err;
+        boost::asio::ip::tcp::endpoint endpoint = guest->inbound->getSocket()->remote_endpoint(err);
+        if (err) {
+            NOAM_LOG_ERROR("host dropping guest \"" << mMessageParser.getRegistration().guestName << "\" - " << err.message());
+            removeGuest(guest);
+            return;
+        }
+        registerGuest(guest, mMessageParser.getRegistration(), endpoint.address().to_string());
+    } else if (mMessageParser.getHeader() == sHeartbeatHeader) {
+        if (guest->heartbeatAck) {
+            sendHeartbeatAck(guest);
+        }
+    } else {
+        NOAM_LOG_ERROR("host received an unknown message header \"" << mMessageParser.getHeader() << "\"");
+    }
+}
+
+void Host::registerGuest(const GuestRef& guest, const MessageParser::Registration& registration, const std::string& address) {
+    if (guest->registered) {
+        NOAM_LOG_ERROR("host received a second registration from guest \"" << guest->name << "\"");
+        return;
+    }
+
+    std::string name(registration.guestName.data(), registration.guestName.size());
+    // a guest registering again under the same name has reconnected, the stale entry goes
+    auto it = std::find_if(mGuests.begin(), mGuests.end(), [&](const GuestRef& other) {
+        return other != guest && other->registered && other->name == name;
+    });
+    if (it != mGuests.end()) {
+        NOAM_LOG_NOTICE("host replacing guest \"" << name << "\"");
+        removeGuest(*it);
+    }
+
+    guest->name = name;
+    guest->registered = true;
+    guest->heartbeatAck = registration.heartbeatAck;
+    guest->compression = Compressor::isAvailable() && registration.compression == Compressor::getName();
+    for (const boost::string_ref& eventName : registration.hears) {
+        guest->hears.push_back(mEventNames.intern(std::string(eventName.data(), eventName.size())));
+    }
+    for (const boost::string_ref& eventName : registration.speaks) {
+        guest->speaks.push_back(std::string(eventName.data(), eventName.size()));
+    }
+    mStats.registrations++;
+    NOAM_LOG_NOTICE("host registered guest \"" << name << "\" hearing " << guest->hears.size() << " events");
+
+    guest->writeQueue = WriteQueue::create(getIoService());
+    guest->writeQueue->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("host TCP client session write - " << err);
+    });
+
+    std::weak_ptr<Guest> weakGuest = guest;
+    guest->client = TcpClient::create(getIoService());
+    guest->client->connectErrorEventHandler([&, weakGuest](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("host TCP client - " << err);
+        GuestRef guest = weakGuest.lock();
+        if (guest && !guest->outbound) {
+            removeGuest(guest);
+        }
+    });
+    guest->client->connectConnectEventHandler([&, weakGuest](TcpSessionRef session) {
+        GuestRef guest = weakGuest.lock();
+        if (!guest) {
+            session->close();
+            return;
+        }
+
+        guest->outbound = session;
+        guest->outbound->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+            NOAM_LOG_ERROR("host TCP client session - " << err);
+        });
+        guest->writeQueue->open(session->getSocket());
+        if (guest->compression) {
+            sendCompressionAgreement(guest);
+        }
+
+        // NB - only subscribed once frames can actually be written
+        subscribeGuest(guest);
+    });
+    guest->client->connect(address, registration.port);
+}
+
+void Host::subscribeGuest(const GuestRef& guest) {
+    for (Symbol symbol : guest->hears) {
+        if (symbol >= mSubscribers.size()) {
+            mSubscribers.resize(symbol + 1);
+        }
+        mSubscribers[symbol].push_back(guest);
+    }
+}
+
+void Host::removeGuest(const GuestRef& guest) {
+    // NB - keep the guest alive until its sessions are shut, the caller may hold the last other reference
+    GuestRef retained = guest;
+
+    for (Symbol symbol : guest->hears) {
+        if (symbol < mSubscribers.size()) {
+            std::vector<GuestRef>& subscribers = mSubscribers[symbol];
+            subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), guest), subscribers.end());
+        }
+    }
+    mGuests.remove(guest);
+
+    if (guest->writeQueue) {
+        guest->writeQueue->close();
+    }
+    if (guest->outbound) {
+        guest->outbound->close();
+    }
+    if (guest->reader) {
+        guest->reader->close();
+    }
+    if (guest->inbound) {
+        guest->inbound->close();
+    }
+}
+
+void Host::routeEvent(const boost::string_ref& frame, boost::string_ref compressedFrame, const boost::string_ref& eventName) {
+    Symbol symbol = mEventNames.find(eventName);
+    if (symbol == sInvalidSymbol || symbol >= mSubscribers.size()) {
+        return;
+    }
+
+    // NB - the frame is copied verbatim into each subscriber's queue, it is never re-encoded and compressed at most once
+    bool compressionTried = !compressedFrame.empty();
+    for (const GuestRef& subscriber : mSubscribers[symbol]) {
+        boost::string_ref subscriberFrame = frame;
+        if (subscriber->compression) {
+            if (!compressionTried && frame.size() >= sCompressionThreshold) {
+                compressionTried = true;
+                if (mCompressor.compress(frame.data(), frame.size())) {
+                    mCompressedFrame.assign(1, Compressor::sFrameMarker);
+                    mCompressedFrame.append(mCompressor.getData(), mCompressor.getSize());
+                    compressedFrame = mCompressedFrame;
+                }
+            }
+            if (!compressedFrame.empty()) {
+                subscriberFrame = compressedFrame;
+            }
+        }
+
+        WriteQueue& writeQueue = *subscriber->writeQueue;
+        std::lock_guard<std::mutex> lock(writeQueue.getMutex());
+        if (writeQueue.getPendingByteCount() > sMaxPendingBytes) {
+            mStats.dropped++;
+            continue;
+        }
+
+        FrameEncoder& encoder = writeQueue.getEncoder();
+        encoder.beginFrame();
+        encoder.appendRaw(subscriberFrame.data(), subscriberFrame.size());
+        encoder.endFrame();
+        writeQueue.commit();
+        mStats.forwarded++;
+    }
+}
+
+void Host::sendHeartbeatAck(const GuestRef& guest) {
+    if (!guest->outbound) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(guest->writeQueue->getMutex());
+    FrameEncoder& encoder = guest->writeQueue->getEncoder();
+    encoder.beginFrame();
+    encoder.appendRaw('[');
+    encoder.appendString(sHeartbeatAckHeader);
+    encoder.appendRaw(',');
+    encoder.appendString(guest->name);
+    encoder.appendRaw(']');
+    encoder.endFrame();
+    // NB - acks skip ahead of forwarded events, the round trip they measure is the host's and not its backlog
+    guest->writeQueue->commit(0, Lane::Control);
+}
+
+void Host::sendCompressionAgreement(const GuestRef& guest) {
+    std::lock_guard<std::mutex> lock(guest->writeQueue->getMutex());
+    FrameEncoder& encoder = guest->writeQueue->getEncoder();
+    encoder.beginFrame();
+    encoder.appendRaw('[');
+    encoder.appendString(sCompressionHeader);
+    encoder.appendRaw(',');
+    encoder.appendString(Compressor::getName());
+    encoder.appendRaw(']');
+    encoder.endFrame();
+    guest->writeQueue->commit();
+}
+
+}}
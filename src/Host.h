@@ -0,0 +1,119 @@
+//
+//  Host.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "UdpServer.h"
+#include "TcpClient.h"
+#include "TcpServer.h"
+#include "FrameReader.h"
+#include "MessageParser.h"
+#include "WriteQueue.h"
+#include "Compressor.h"
+#include "SymbolTable.h"
+#include "LoopbackTransport.h"
+#include <list>
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class Host> HostRef;
+
+// In-process Noam host. Answers availability broadcasts, accepts guest registrations and routes event frames to every
+//  guest that hears the event. Frames are forwarded as received, each subscriber gets its own write queue so a slow guest
+//  only holds up itself. Guests advertising compression get large frames deflated, compressed once however many hear them.
+class Host : public std::enable_shared_from_this<Host> {
+public:
+    struct Stats {
+        Stats() : registrations(0), events(0), forwarded(0), dropped(0) {}
+
+        uint64_t registrations;
+        uint64_t events;
+        // frames written to subscribers, an event heard by n guests counts n times
+        uint64_t forwarded;
+        // frames not forwarded because a subscriber fell too far behind
+        uint64_t dropped;
+    };
+
+    static const uint16_t sDefaultPort = 7733;
+
+    // a guest broadcasting for a room is only answered when it matches, guests without a room are always answered
+    static HostRef create(const std::string& roomName = "", uint16_t port = sDefaultPort);
+    // runs on the given io_service rather than the app's, e.g. without an app at all
+    static HostRef create(boost::asio::io_service& io, const std::string& roomName = "", uint16_t port = sDefaultPort);
+    ~Host();
+
+    void begin();
+    void end();
+
+    inline bool isRunning() const { return mRunning; }
+    inline uint16_t getPort() const { return mPort; }
+    inline size_t getGuestCount() const { return mGuests.size(); }
+    inline const Stats& getStats() const { return mStats; }
+
+    // lemmas in this process can skip the sockets with a transport from the hub, their events still reach TCP guests
+    //  and vice versa
+    LoopbackHubRef getLoopbackHub();
+
+private:
+    struct Guest {
+        Guest() : registered(false), heartbeatAck(false), compression(false) {}
+
+        std::string name;
+        bool registered;
+        bool heartbeatAck;
+        bool compression;
+        std::vector<Symbol> hears;
+        std::vector<std::string> speaks;
+        // guest to host
+        TcpSessionRef inbound;
+        FrameReaderRef reader;
+        // host to guest, connected back to the port the guest registered with
+        TcpClientRef client;
+        TcpSessionRef outbound;
+        WriteQueueRef writeQueue;
+    };
+    typedef std::shared_ptr<Guest> GuestRef;
+
+    Host(boost::asio::io_service& io, const std::string& roomName, uint16_t port);
+
+    inline boost::asio::io_service& getIoService() { return *mIoService; }
+
+    void setupDiscoveryServer();
+    void setupMessagingServer();
+    void handleMessage(const GuestRef& guest, const boost::string_ref& frame);
+    void registerGuest(const GuestRef& guest, const MessageParser::Registration& registration, const std::string& address);
+    void subscribeGuest(const GuestRef& guest);
+    void removeGuest(const GuestRef& guest);
+    // to TCP guests, the frame is the JSON without the length prefix, compressedFrame the frame as received if it was compressed
+    void routeEvent(const boost::string_ref& frame, boost::string_ref compressedFrame, const boost::string_ref& eventName);
+    void sendHeartbeatAck(const GuestRef& guest);
+    void sendCompressionAgreement(const GuestRef& guest);
+
+    std::string mRoomName;
+    uint16_t mPort;
+    bool mRunning;
+    boost::asio::io_service* mIoService;
+
+    UdpServerRef mUDPServer;
+    UdpSessionRef mUDPServerSession;
+    TcpServerRef mTCPServer;
+
+    std::list<GuestRef> mGuests;
+    MessageParser mMessageParser;
+    Compressor mCompressor;
+    Compressor mDecompressor;
+    std::string mCompressedFrame;
+    // subscribers indexed by event name symbol
+    SymbolTable mEventNames;
+    std::vector<std::vector<GuestRef>> mSubscribers;
+    LoopbackHubRef mLoopbackHub;
+
+    Stats mStats;
+};
+
+}}
@@ -0,0 +1,60 @@
+//
+//  IoServicePool.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "IoServicePool.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+IoServicePoolRef IoServicePool::create(size_t threadCount) {
+    return IoServicePoolRef(new IoServicePool(threadCount));
+}
+
+IoServicePool::IoServicePool(size_t threadCount) : mNext(0) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (size_t idx = 0; idx < threadCount; idx++) {
+        mIoServices.emplace_back(new boost::asio::io_service());
+        mIoWork.emplace_back(new boost::asio::io_service::work(*mIoServices.back()));
+    }
+    // NB - started once all are in place, a handler may well ask for another io_service right away
+    for (size_t idx = 0; idx < threadCount; idx++) {
+        boost::asio::io_service* io = mIoServices[idx].get();
+        mIoThreads.emplace_back([io]() {
+            io->run();
+        });
+    }
+}
+
+IoServicePool::~IoServicePool() {
+    stop();
+}
+
+#pragma mark -
+
+boost::asio::io_service& IoServicePool::getNextIoService() {
+    boost::asio::io_service& io = *mIoServices[mNext];
+    mNext = (mNext + 1) % mIoServices.size();
+    return io;
+}
+
+void IoServicePool::stop() {
+    mIoWork.clear();
+    for (auto& io : mIoServices) {
+        io->stop();
+    }
+    for (std::thread& thread : mIoThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+}}
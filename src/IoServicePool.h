@@ -0,0 +1,45 @@
+//
+//  IoServicePool.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <boost/asio.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class IoServicePool> IoServicePoolRef;
+
+// io_services each run by a thread of its own. Handlers for whatever is created on one of them, a lemma with its sessions
+//  and timers, are serialized on that thread as a strand would, yet the pool as a whole spreads across cores.
+class IoServicePool {
+public:
+    // 0 for one per core
+    static IoServicePoolRef create(size_t threadCount = 1);
+    ~IoServicePool();
+
+    inline size_t getSize() const { return mIoServices.size(); }
+    inline boost::asio::io_service& getIoService(size_t idx = 0) { return *mIoServices[idx]; }
+    // round robin
+    boost::asio::io_service& getNextIoService();
+
+    // handlers in progress complete, pending ones are abandoned, then the threads are joined
+    void stop();
+
+private:
+    IoServicePool(size_t threadCount);
+
+    std::vector<std::unique_ptr<boost::asio::io_service>> mIoServices;
+    std::vector<std::unique_ptr<boost::asio::io_service::work>> mIoWork;
+    std::vector<std::thread> mIoThreads;
+    size_t mNext;
+};
+
+}}
@@ -0,0 +1,371 @@
+//
+//  JsonReader.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "JsonReader.h"
+#include "JsonScanner.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#if defined(_MSC_VER)
+    #include <locale.h>
+#elif defined(__APPLE__)
+    #include <xlocale.h>
+#else
+    #include <locale.h>
+#endif
+
+namespace Cinder { namespace Noam {
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static bool readHex4(const char* data, uint32_t& value) {
+    value = 0;
+    for (size_t idx = 0; idx < 4; idx++) {
+        int digit = hexValue(data[idx]);
+        if (digit < 0) {
+            return false;
+        }
+        value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+    return true;
+}
+
+static void appendUTF8(std::string& output, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        output.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        output.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        output.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        output.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+JsonReader::JsonReader() : mBegin(nullptr), mPosition(nullptr), mEnd(nullptr) {
+}
+
+void JsonReader::reset(const boost::string_ref& json) {
+    mBegin = mPosition = json.data();
+    mEnd = json.data() + json.size();
+    mError.clear();
+
+    mScratch.clear();
+}
+
+#pragma mark -
+
+bool JsonReader::consume(char c) {
+    skipWhitespace();
+    if (mPosition < mEnd && *mPosition == c) {
+        ++mPosition;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::expect(char c) {
+    if (consume(c)) {
+        return true;
+    }
+    const char message[] = {'e', 'x', 'p', 'e', 'c', 't', 'e', 'd', ' ', '\'', c, '\'', '\0'};
+    return fail(message);
+}
+
+bool JsonReader::readString(boost::string_ref& value) {
+    skipWhitespace();
+    if (mPosition >= mEnd || *mPosition != '"') {
+        return fail("expected string");
+    }
+    const char* start = ++mPosition;
+
+    // plain strings are handed out in place
+    mPosition += JsonScanner::findSpecial(mPosition, static_cast<size_t>(mEnd - mPosition));
+    if (mPosition >= mEnd) {
+        return fail("unterminated string");
+    }
+    if (*mPosition == '"') {
+        if (!JsonScanner::isValidUTF8(start, static_cast<size_t>(mPosition - start))) {
+            return fail("invalid UTF-8 in string");
+        }
+        value = boost::string_ref(start, static_cast<size_t>(mPosition - start));
+        ++mPosition;
+        return true;
+    } else if (*mPosition != '\\') {
+        return fail("control character in string");
+    }
+
+    // escaped strings are unescaped into the scratch buffer. NB - unescaping never grows a string, reserving the
+    //  document size before the first one keeps the views of later ones valid, plain documents never touch it
+    if (mScratch.capacity() < static_cast<size_t>(mEnd - mBegin)) {
+        mScratch.reserve(static_cast<size_t>(mEnd - mBegin));
+    }
+    size_t offset = mScratch.size();
+    mScratch.append(start, mPosition);
+    while (true) {
+        // copy up to the next escape or the end of the string in one go
+        const char* run = mPosition;
+        mPosition += JsonScanner::findSpecial(mPosition, static_cast<size_t>(mEnd - mPosition));
+        mScratch.append(run, mPosition);
+        if (mPosition >= mEnd) {
+            return fail("unterminated string");
+        }
+        char c = *mPosition++;
+        if (c == '"') {
+            break;
+        } else if (c != '\\') {
+            return fail("control character in string");
+        }
+
+        if (mPosition >= mEnd) {
+            return fail("unterminated string");
+        }
+        char escape = *mPosition++;
+        switch (escape) {
+            case '"': mScratch.push_back('"'); break;
+            case '\\': mScratch.push_back('\\'); break;
+            case '/': mScratch.push_back('/'); break;
+            case 'b': mScratch.push_back('\b'); break;
+            case 'f': mScratch.push_back('\f'); break;
+            case 'n': mScratch.push_back('\n'); break;
+            case 'r': mScratch.push_back('\r'); break;
+            case 't': mScratch.push_back('\t'); break;
+            case 'u': {
+                uint32_t codePoint = 0;
+                if (mEnd - mPosition < 4 || !readHex4(mPosition, codePoint)) {
+                    return fail("invalid unicode escape");
+                }
+                mPosition += 4;
+                // combine a surrogate pair
+                uint32_t low = 0;
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF && mEnd - mPosition >= 6 && mPosition[0] == '\\' && mPosition[1] == 'u' && readHex4(mPosition + 2, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    mPosition += 6;
+                }
+                // NB - a surrogate left unpaired has no UTF-8 encoding, it becomes U+FFFD as any ill formed sequence would
+                if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+                    codePoint = 0xFFFD;
+                }
+                appendUTF8(mScratch, codePoint);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+        }
+    }
+
+    // NB - escapes produce well formed sequences, unpaired surrogates having been replaced, so only the raw bytes in
+    //  between need checking
+    if (!JsonScanner::isValidUTF8(start, static_cast<size_t>(mPosition - 1 - start))) {
+        return fail("invalid UTF-8 in string");
+    }
+    value = boost::string_ref(mScratch.data() + offset, mScratch.size() - offset);
+    return true;
+}
+
+bool JsonReader::readValue(EventValue& value) {
+    skipWhitespace();
+    if (mPosition >= mEnd) {
+        return fail("expected value");
+    }
+
+    const char* start = mPosition;
+    switch (*mPosition) {
+        case '"': {
+            boost::string_ref string;
+            if (!readString(string)) {
+                return false;
+            }
+            value = EventValue::makeString(string, boost::string_ref(start, static_cast<size_t>(mPosition - start)));
+            return true;
+        }
+        case '[':
+        case '{': {
+            EventValue::Type type = *mPosition == '[' ? EventValue::Type::Array : EventValue::Type::Object;
+            if (!skipComposite()) {
+                return false;
+            }
+            value = EventValue::makeComposite(type, boost::string_ref(start, static_cast<size_t>(mPosition - start)));
+            return true;
+        }
+        case 't':
+            if (!readLiteral("true", 4)) {
+                return false;
+            }
+            value = EventValue::makeBool(true, boost::string_ref(start, 4));
+            return true;
+        case 'f':
+            if (!readLiteral("false", 5)) {
+                return false;
+            }
+            value = EventValue::makeBool(false, boost::string_ref(start, 5));
+            return true;
+        case 'n':
+            if (!readLiteral("null", 4)) {
+                return false;
+            }
+            value = EventValue();
+            return true;
+        default:
+            return readNumber(value);
+    }
+}
+
+bool JsonReader::skipValue() {
+    EventValue value;
+    return readValue(value);
+}
+
+bool JsonReader::atEnd() {
+    skipWhitespace();
+    return mPosition >= mEnd;
+}
+
+#pragma mark -
+
+void JsonReader::skipWhitespace() {
+    while (mPosition < mEnd && (*mPosition == ' ' || *mPosition == '\n' || *mPosition == '\r' || *mPosition == '\t')) {
+        ++mPosition;
+    }
+}
+
+// strtod in the "C" locale whatever the process is set to, under de_DE strtod alone stops at the '.' of "0.5"
+static double parseDouble(const char* json) {
+#if defined(_MSC_VER)
+    static _locale_t sLocale = _create_locale(LC_NUMERIC, "C");
+    return _strtod_l(json, nullptr, sLocale);
+#else
+    static locale_t sLocale = newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+    return strtod_l(json, nullptr, sLocale);
+#endif
+}
+
+bool JsonReader::readNumber(EventValue& value) {
+    const char* start = mPosition;
+    bool negative = false;
+    bool integral = true;
+    bool overflow = false;
+    uint64_t magnitude = 0;
+
+    if (mPosition < mEnd && *mPosition == '-') {
+        negative = true;
+        ++mPosition;
+    }
+    const char* digits = mPosition;
+    while (mPosition < mEnd && *mPosition >= '0' && *mPosition <= '9') {
+        uint64_t digit = static_cast<uint64_t>(*mPosition - '0');
+        if (magnitude > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            overflow = true;
+        }
+        magnitude = magnitude * 10 + digit;
+        ++mPosition;
+    }
+    if (mPosition == digits) {
+        return fail("invalid value");
+    }
+    if (mPosition < mEnd && *mPosition == '.') {
+        integral = false;
+        ++mPosition;
+        while (mPosition < mEnd && *mPosition >= '0' && *mPosition <= '9') {
+            ++mPosition;
+        }
+    }
+    if (mPosition < mEnd && (*mPosition == 'e' || *mPosition == 'E')) {
+        integral = false;
+        ++mPosition;
+        if (mPosition < mEnd && (*mPosition == '+' || *mPosition == '-')) {
+            ++mPosition;
+        }
+        while (mPosition < mEnd && *mPosition >= '0' && *mPosition <= '9') {
+            ++mPosition;
+        }
+    }
+
+    boost::string_ref json(start, static_cast<size_t>(mPosition - start));
+    uint64_t limit = negative ? static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1 : static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (integral && !overflow && magnitude <= limit) {
+        int64_t result = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+        value = EventValue::makeInt(result, json);
+        return true;
+    }
+
+    // NB - strtod needs a terminated string, numbers are short enough for the stack
+    char buffer[64];
+    if (json.size() < sizeof(buffer)) {
+        std::copy(json.begin(), json.end(), buffer);
+        buffer[json.size()] = '\0';
+        value = EventValue::makeDouble(parseDouble(buffer), json);
+    } else {
+        value = EventValue::makeDouble(parseDouble(std::string(json.data(), json.size()).c_str()), json);
+    }
+    return true;
+}
+
+bool JsonReader::readLiteral(const char* literal, size_t length) {
+    if (static_cast<size_t>(mEnd - mPosition) < length || std::string::traits_type::compare(mPosition, literal, length) != 0) {
+        return fail("invalid literal");
+    }
+    mPosition += length;
+    return true;
+}
+
+bool JsonReader::skipComposite() {
+    // NB - only balances brackets, the contents are validated if and when they are parsed
+    size_t depth = 0;
+    while (mPosition < mEnd) {
+        char c = *mPosition++;
+        if (c == '[' || c == '{') {
+            depth++;
+        } else if (c == ']' || c == '}') {
+            if (--depth == 0) {
+                return true;
+            }
+        } else if (c == '"') {
+            while (mPosition < mEnd) {
+                mPosition += JsonScanner::findSpecial(mPosition, static_cast<size_t>(mEnd - mPosition));
+                if (mPosition >= mEnd) {
+                    break;
+                } else if (*mPosition == '"') {
+                    ++mPosition;
+                    break;
+                }
+                // an escape, or a control character left for the parse to reject
+                mPosition += (*mPosition == '\\' && mEnd - mPosition > 1) ? 2 : 1;
+            }
+        } else {
+            // jump to the next bracket or string
+            mPosition += JsonScanner::findStructural(mPosition, static_cast<size_t>(mEnd - mPosition));
+        }
+    }
+    return fail("unterminated array or object");
+}
+
+bool JsonReader::fail(const char* message) {
+    if (mError.empty()) {
+        mError = std::string(message) + " at offset " + std::to_string(static_cast<long long>(mPosition - mBegin));
+    }
+    return false;
+}
+
+}}
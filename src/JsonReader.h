@@ -0,0 +1,51 @@
+//
+//  JsonReader.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "EventValue.h"
+#include <string>
+
+namespace Cinder { namespace Noam {
+
+// Forward-only pull reader over a JSON document, the caller walks the structure it expects.
+//  Unescaped strings are written to a scratch buffer sized on first use so views stay valid until the next reset().
+class JsonReader {
+public:
+    JsonReader();
+
+    void reset(const boost::string_ref& json);
+
+    // consume the character if it is next, skipping whitespace
+    bool consume(char c);
+    // like consume() but records an error when the character is missing
+    bool expect(char c);
+    bool readString(boost::string_ref& value);
+    bool readValue(EventValue& value);
+    bool skipValue();
+    // whitespace only until the end of the document
+    bool atEnd();
+
+    inline bool hasError() const { return !mError.empty(); }
+    inline const std::string& getError() const { return mError; }
+
+private:
+    void skipWhitespace();
+    bool readNumber(EventValue& value);
+    bool readLiteral(const char* literal, size_t length);
+    bool skipComposite();
+    bool fail(const char* message);
+
+    const char* mBegin;
+    const char* mPosition;
+    const char* mEnd;
+    std::string mScratch;
+    std::string mError;
+};
+
+}}
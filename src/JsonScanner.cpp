@@ -0,0 +1,192 @@
+//
+//  JsonScanner.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "JsonScanner.h"
+#include <cstdint>
+
+#if NOAM_ENABLE_SIMD && defined(__AVX2__)
+    #define NOAM_SIMD_AVX2 1
+    #include <immintrin.h>
+#elif NOAM_ENABLE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define NOAM_SIMD_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace Cinder { namespace Noam {
+
+static inline bool isSpecial(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+static inline bool isStructural(unsigned char c) {
+    // NB - setting bit 5 maps '[' onto '{' and ']' onto '}' and nothing else onto either
+    return (c | 0x20) == '{' || (c | 0x20) == '}' || c == '"';
+}
+
+#if NOAM_SIMD_AVX2 || NOAM_SIMD_SSE2
+static inline size_t countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx = 0;
+    _BitScanForward(&idx, mask);
+    return idx;
+#else
+    return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// length of the sequence starting at data, 0 when it is malformed or truncated
+static size_t getSequenceLength(const unsigned char* data, size_t size) {
+    unsigned char c = data[0];
+    if (c < 0x80) {
+        return 1;
+    } else if (c < 0xC2) {
+        // a stray continuation byte or an overlong two byte form
+        return 0;
+    } else if (c < 0xE0) {
+        return size >= 2 && (data[1] & 0xC0) == 0x80 ? 2 : 0;
+    } else if (c < 0xF0) {
+        if (size < 3) {
+            return 0;
+        }
+        // NB - E0 would be overlong below A0, ED a surrogate from A0
+        unsigned char low = c == 0xE0 ? 0xA0 : 0x80;
+        unsigned char high = c == 0xED ? 0x9F : 0xBF;
+        return data[1] >= low && data[1] <= high && (data[2] & 0xC0) == 0x80 ? 3 : 0;
+    } else if (c < 0xF5) {
+        if (size < 4) {
+            return 0;
+        }
+        // NB - F0 would be overlong below 90, F4 past U+10FFFF from 90
+        unsigned char low = c == 0xF0 ? 0x90 : 0x80;
+        unsigned char high = c == 0xF4 ? 0x8F : 0xBF;
+        return data[1] >= low && data[1] <= high && (data[2] & 0xC0) == 0x80 && (data[3] & 0xC0) == 0x80 ? 4 : 0;
+    }
+    return 0;
+}
+
+const char* JsonScanner::getInstructionSet() {
+#if NOAM_SIMD_AVX2
+    return "AVX2";
+#elif NOAM_SIMD_SSE2
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+#pragma mark -
+
+size_t JsonScanner::findSpecial(const char* data, size_t size) {
+    size_t idx = 0;
+#if NOAM_SIMD_AVX2
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    for (; idx + 32 <= size; idx += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + idx));
+        // NB - there are no unsigned byte compares, a byte is a control character when min(c, 0x1F) leaves it as is
+        __m256i match = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)), _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if (mask) {
+            return idx + countTrailingZeros(mask);
+        }
+    }
+#elif NOAM_SIMD_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + idx));
+        // NB - there are no unsigned byte compares, a byte is a control character when min(c, 0x1F) leaves it as is
+        __m128i match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(match));
+        if (mask) {
+            return idx + countTrailingZeros(mask);
+        }
+    }
+#endif
+    for (; idx < size; idx++) {
+        if (isSpecial(static_cast<unsigned char>(data[idx]))) {
+            return idx;
+        }
+    }
+    return size;
+}
+
+size_t JsonScanner::findStructural(const char* data, size_t size) {
+    size_t idx = 0;
+#if NOAM_SIMD_AVX2
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i open = _mm256_set1_epi8('{');
+    const __m256i close = _mm256_set1_epi8('}');
+    const __m256i bit5 = _mm256_set1_epi8(0x20);
+    for (; idx + 32 <= size; idx += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + idx));
+        __m256i folded = _mm256_or_si256(chunk, bit5);
+        __m256i match = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)), _mm256_cmpeq_epi8(chunk, quote));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if (mask) {
+            return idx + countTrailingZeros(mask);
+        }
+    }
+#elif NOAM_SIMD_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    const __m128i bit5 = _mm_set1_epi8(0x20);
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + idx));
+        __m128i folded = _mm_or_si128(chunk, bit5);
+        __m128i match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)), _mm_cmpeq_epi8(chunk, quote));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(match));
+        if (mask) {
+            return idx + countTrailingZeros(mask);
+        }
+    }
+#endif
+    for (; idx < size; idx++) {
+        if (isStructural(static_cast<unsigned char>(data[idx]))) {
+            return idx;
+        }
+    }
+    return size;
+}
+
+bool JsonScanner::isValidUTF8(const char* data, size_t size) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t idx = 0;
+    while (idx < size) {
+        // skip ASCII a vector at a time, only sequences are checked byte by byte
+#if NOAM_SIMD_AVX2
+        while (idx + 32 <= size && _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + idx))) == 0) {
+            idx += 32;
+        }
+#elif NOAM_SIMD_SSE2
+        while (idx + 16 <= size && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + idx))) == 0) {
+            idx += 16;
+        }
+#endif
+        if (idx >= size) {
+            break;
+        }
+
+        size_t length = getSequenceLength(bytes + idx, size - idx);
+        if (length == 0) {
+            return false;
+        }
+        idx += length;
+    }
+    return true;
+}
+
+}}
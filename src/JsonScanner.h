@@ -0,0 +1,35 @@
+//
+//  JsonScanner.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+
+// vectorized scanning, AVX2 when the target has it, otherwise SSE2. Define as 0 to build the scalar fallback only
+#ifndef NOAM_ENABLE_SIMD
+    #define NOAM_ENABLE_SIMD 1
+#endif
+
+namespace Cinder { namespace Noam {
+
+// The byte searches behind JsonReader and FrameEncoder, 16 or 32 bytes at a time. Each returns the offset of the first
+//  match or size when there is none, so runs of plain bytes are skipped without looking at them one by one.
+class JsonScanner {
+public:
+    // "AVX2", "SSE2" or "scalar", as compiled
+    static const char* getInstructionSet();
+
+    // the first '"', '\\' or control character, i.e. what ends a plain string and what has to be escaped
+    static size_t findSpecial(const char* data, size_t size);
+    // the first '"', '[', ']', '{' or '}'
+    static size_t findStructural(const char* data, size_t size);
+    // well formed UTF-8, no overlong forms, surrogates or code points past U+10FFFF
+    static bool isValidUTF8(const char* data, size_t size);
+};
+
+}}
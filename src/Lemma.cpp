@@ -7,8 +7,12 @@
 //
 
 #include "Lemma.h"
+#include "LemmaPool.h"
+#include "Log.h"
+#include "Base64.h"
 #include "cinder/app/App.h"
-#include "boost/format.hpp"
+#include <algorithm>
+#include <fstream>
 
 namespace Cinder { namespace Noam {
 
@@ -17,349 +21,776 @@ using namespace ci;
 static const std::string sLemmaDialect = "Cinder-NoamLemma";
 static const std::string sLemmaVersion = "0.0.0";
 
-static const std::string sAvailabilityBroadcastHost = "255.255.255.255";
-static const uint16_t sAvailabilityBroadcastPort = 1030;
-static const size_t sAvailabilityBroadcastInterval = 3 * 1000;
 static const std::string sAvailabilityBroadcastHeader = "marco";
-static const std::string sAvailabilityBroadcastResponseHeader = "polo";
+
+static const size_t sConnectTimeout = 2 * 1000;
+static const size_t sReconnectInterval = 1 * 1000;
+static const size_t sMaxUnacknowledgedHeartbeats = 16;
 
 static const std::string sRegistrationMessageHeader = "register";
 static const std::string sHeartbeatHeader = "heartbeat";
-static const size_t sHeartbeatInterval = 5 * 1000;
 static const std::string sHeartbeatAckHeader = "heartbeat_ack";
 static const std::string sEventMessageHeader = "event";
+static const std::string sCompressionHeader = "compression";
+
+// typed values handed to a transport as they are, no JSON
+static inline EventValue makeEventValue(bool value) { return EventValue::makeBool(value, boost::string_ref()); }
+static inline EventValue makeEventValue(int value) { return EventValue::makeInt(value, boost::string_ref()); }
+static inline EventValue makeEventValue(float value) { return EventValue::makeDouble(value, boost::string_ref()); }
+static inline EventValue makeEventValue(double value) { return EventValue::makeDouble(value, boost::string_ref()); }
+static inline EventValue makeEventValue(const std::string& value) { return EventValue::makeString(value, boost::string_ref()); }
+static inline EventValue makeEventValue(const char* value) { return EventValue::makeString(value, boost::string_ref()); }
+
+const size_t Lemma::sHeartbeatInterval;
 
-LemmaRef Lemma::create(const std::string& guestName, const std::string& roomName) {
-    return LemmaRef(new Lemma(guestName, roomName))->shared_from_this();
+LemmaRef Lemma::create(const std::string& guestName, const std::string& roomName, const Format& format) {
+    return LemmaRef(new Lemma(guestName, roomName, format))->shared_from_this();
 }
 
-Lemma::Lemma(const std::string& guestName, const std::string& roomName) : mConnected(false), mGuestName(guestName), mRoomName(roomName) {
+Lemma::Lemma(const std::string& guestName, const std::string& roomName, const Format& format, LemmaPool* pool) : mConnected(false), mGuestName(guestName), mRoomName(roomName), mQuotedGuestName(FrameEncoder::quote(guestName)), mHeardEvents(std::make_shared<HeardEvents>()), mNextHandlerId(0), mDispatching(false), mHandlerRemovalPending(false), mDroppedEventCount(0), mFormat(format), mPool(pool), mIoService(pool ? &pool->getNextIoService() : format.getIoService()), mAppIoService(pool && pool->isAppIoService()), mDirectPort(0), mCachedPort(0), mConnecting(false), mConnectingPort(0), mConnectingDiscovered(false), mConnectDuration(0.0), mHeartbeatAcknowledged(false), mHeartbeating(false) {
+    if (mPool) {
+        // NB - the pool runs the I/O, and discovery, for all of its lemmas
+        if (mPool->isThreaded()) {
+            mEventQueue.reset(new EventQueue(mFormat.getEventQueueCapacity()));
+        }
+    } else if (mFormat.isThreaded()) {
+        if (!mIoService) {
+            mIoServicePool = IoServicePool::create(1);
+            mIoService = &mIoServicePool->getIoService();
+        }
+        mEventQueue.reset(new EventQueue(mFormat.getEventQueueCapacity()));
+    }
+    if (!mIoService) {
+        mIoService = &ci::app::App::get()->io_service();
+        mAppIoService = true;
+    }
+
+    if (!mPool) {
+        mDiscovery = Discovery::create(getIoService(), mFormat.getDiscoveryScheduleFormat());
+        mDiscovery->connectHostEventHandler([&](const std::string& host, uint16_t port) {
+            setupMessagingClient(host, port, true);
+        });
+    }
+    loadHostCache();
+
+    // NB - pooled lemmas all beat on the pool's timer. Armed once to repeat, re-arming a pending wait cancels it
+    if (!mPool) {
+        mHeartbeatTimer = WaitTimer::create(getIoService());
+        mHeartbeatTimer->connectErrorEventHandler([](std::string message, size_t arg) {
+            NOAM_LOG_ERROR("heartbeat timer - " << message << " " << arg);
+        });
+        mHeartbeatTimer->connectWaitEventHandler([&]() {
+            sendHeartbeatMessage();
+        });
+    }
+
+    if (mFormat.isSendBuffered()) {
+        mSendBuffer = SendBuffer::create(mFormat.getSendBufferFormat());
+    }
+
+    mWriteQueue = WriteQueue::create(getIoService());
+    mWriteQueue->setBudget(mFormat.getSendBudgetBytes(), mFormat.getSendBudgetFrames());
+    mWriteQueue->setWatermarks(mFormat.getLowWatermark(), mFormat.getHighWatermark());
+    mWriteQueue->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("TCP client session write - " << err);
+    });
+    mWriteQueue->connectWriteEventHandler([&](size_t bytesTransferred) {
+        NOAM_LOG_NOTICE("TCP client session wrote " << bytesTransferred << " bytes");
+        mMetrics.increment(Metrics::Counter::Writes);
+        mMetrics.increment(Metrics::Counter::BytesOut, bytesTransferred);
+        mMetrics.trace(Metrics::Trace::WriteComplete, boost::string_ref(), bytesTransferred);
+    });
+
+    mFrameReader = FrameReader::create();
+    mFrameReader->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("TCP server session read - " << err);
+    });
+    mFrameReader->connectReadEventHandler([&](size_t bytesTransferred) {
+        // NB - reads are not aligned to frames, one can hold several messages and a message can span several reads.
+        //  Multiple messages at once could occur on OS X Mavericks+ via Timer Coalescing
+        //  see Cinder-AppNap https://github.com/pizthewiz/Cinder-AppNap to tweak Timer Coalescing behavior
+        mMetrics.increment(Metrics::Counter::BytesIn, bytesTransferred);
+        mMetrics.trace(Metrics::Trace::Read, boost::string_ref(), bytesTransferred);
+    });
+    mFrameReader->connectFrameEventHandler([&](const boost::string_ref& frame) {
+        mMetrics.increment(Metrics::Counter::FramesIn);
+        handleMessage(frame);
+    });
+    mFrameReader->connectFrameErrorEventHandler([&](const std::string& err) {
+        NOAM_LOG_ERROR(err);
+        mMetrics.increment(Metrics::Counter::ParseErrors);
+
+        // the stream can no longer be framed, reconnect
+        mMetrics.increment(Metrics::Counter::Reconnects);
+        end();
+        mBeginTime = std::chrono::steady_clock::now();
+        connect();
+    });
+    mFrameReader->connectReadCompleteEventHandler([&]() {
+        NOAM_LOG_NOTICE("TCP server session read complete");
+
+        // occurs when fired by the host server or the host server dies, retry the host right away and rediscover
+        mMetrics.increment(Metrics::Counter::Reconnects);
+        end();
+        mBeginTime = std::chrono::steady_clock::now();
+        connect();
+    });
 }
 
 Lemma::~Lemma() {
+    // NB - stop the I/O thread before tearing down what its handlers touch
+    if (mIoServicePool) {
+        mIoServicePool->stop();
+    }
+
     end();
 
-    mAvailabilityBroadcastTimer = nullptr;
-    mUDPClient = nullptr;
-    mUDPClientSession = nullptr;
-    mUDPServer = nullptr;
-    mUDPServerSession = nullptr;
+    mDiscovery = nullptr;
     mTCPClient = nullptr;
     mTCPClientSession = nullptr;
     mTCPServer = nullptr;
     mTCPServerSession = nullptr;
     mHeartbeatTimer = nullptr;
+    mReconnectTimer = nullptr;
+    mWriteQueue = nullptr;
+    mFrameReader = nullptr;
+    mSendBuffer = nullptr;
 }
 
 #pragma mark -
 
 void Lemma::connectMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const std::string&)>& eventHandler) {
-    if (mMessageEventHandlerMap.count(eventName)) {
-        cinder::app::console() << "NOTICE - replacing message event handler for event \"" << eventName << "\"" << std::endl;
+    connectMessageEventHandler(eventName, [eventHandler](const std::string& eventName, const EventValue& eventValue) {
+        eventHandler(eventName, eventValue.toString());
+    });
+}
+
+void Lemma::connectMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const EventValue&)>& eventHandler) {
+    // replaces whatever was registered for exactly this event name or prefix
+    std::vector<size_t> handlerIds;
+    if (!eventName.empty() && eventName.back() == '*') {
+        for (const auto& entry : mPrefixMessageEventHandlers) {
+            if (entry.id != 0 && entry.prefix.size() == eventName.size() - 1 && eventName.compare(0, entry.prefix.size(), entry.prefix) == 0) {
+                handlerIds.push_back(entry.id);
+            }
+        }
+    } else {
+        Symbol symbol = mEventNames.find(eventName);
+        if (symbol != sInvalidSymbol) {
+            for (const auto& entry : mMessageEventHandlers[symbol]) {
+                if (entry.id != 0) {
+                    handlerIds.push_back(entry.id);
+                }
+            }
+        }
+    }
+    for (size_t handlerId : handlerIds) {
+        removeMessageEventHandler(handlerId);
+    }
+    bool replaced = !handlerIds.empty();
+    if (replaced) {
+        NOAM_LOG_NOTICE("replacing message event handler for event \"" << eventName << "\"");
     }
-    mMessageEventHandlerMap[eventName] = eventHandler;
+
+    addMessageEventHandler(eventName, eventHandler);
 }
 
-void Lemma::sendMessage(const std::string& eventName, bool eventValue) {
-    sendEventMessage(eventName, eventValue);
+size_t Lemma::addMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const std::string&)>& eventHandler) {
+    return addMessageEventHandler(eventName, [eventHandler](const std::string& eventName, const EventValue& eventValue) {
+        eventHandler(eventName, eventValue.toString());
+    });
 }
 
-void Lemma::sendMessage(const std::string& eventName, double eventValue) {
-    sendEventMessage(eventName, eventValue);
+size_t Lemma::addMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const EventValue&)>& eventHandler) {
+    size_t handlerId = ++mNextHandlerId;
+    if (!eventName.empty() && eventName.back() == '*') {
+        PrefixMessageEventHandler entry = {handlerId, eventName.substr(0, eventName.size() - 1), eventHandler};
+        mPrefixMessageEventHandlers.push_back(entry);
+        NOAM_LOG_NOTICE("prefix handler \"" << eventName << "\" only sees events heard by full name");
+    } else {
+        MessageEventHandler entry = {handlerId, eventHandler};
+        mMessageEventHandlers[internEventName(eventName)].push_back(entry);
+    }
+    publishHeardEvents();
+    return handlerId;
 }
 
-void Lemma::sendMessage(const std::string& eventName, float eventValue) {
-    sendEventMessage(eventName, eventValue);
+void Lemma::removeMessageEventHandler(size_t handlerId) {
+    // NB - while dispatching, entries are only marked and erased once dispatch is done, a handler may remove itself
+    for (auto& handlers : mMessageEventHandlers) {
+        for (auto it = handlers.begin(); it != handlers.end(); ++it) {
+            if (it->id != handlerId) {
+                continue;
+            }
+            if (mDispatching) {
+                it->id = 0;
+                mHandlerRemovalPending = true;
+            } else {
+                handlers.erase(it);
+            }
+            publishHeardEvents();
+            return;
+        }
+    }
+    for (auto it = mPrefixMessageEventHandlers.begin(); it != mPrefixMessageEventHandlers.end(); ++it) {
+        if (it->id != handlerId) {
+            continue;
+        }
+        if (mDispatching) {
+            it->id = 0;
+            mHandlerRemovalPending = true;
+        } else {
+            mPrefixMessageEventHandlers.erase(it);
+        }
+        publishHeardEvents();
+        return;
+    }
 }
 
-void Lemma::sendMessage(const std::string& eventName, int eventValue) {
-    sendEventMessage(eventName, eventValue);
+SendStatus Lemma::sendMessage(const std::string& eventName, bool eventValue) {
+    return sendEventMessage(eventName, eventValue);
 }
 
-void Lemma::sendMessage(const std::string& eventName, const std::string& eventValue) {
-    sendEventMessage(eventName, eventValue);
+SendStatus Lemma::sendMessage(const std::string& eventName, double eventValue) {
+    return sendEventMessage(eventName, eventValue);
 }
 
-void Lemma::sendMessage(const std::string& eventName, const char* eventValue) {
-    sendEventMessage(eventName, std::string(eventValue));
+SendStatus Lemma::sendMessage(const std::string& eventName, float eventValue) {
+    return sendEventMessage(eventName, eventValue);
 }
 
-void Lemma::sendMessage(const std::string& eventName, const JsonTree& eventValue) {
-    sendEventMessage(eventName, eventValue);
+SendStatus Lemma::sendMessage(const std::string& eventName, int eventValue) {
+    return sendEventMessage(eventName, eventValue);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const std::string& eventValue) {
+    return sendEventMessage(eventName, eventValue);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const char* eventValue) {
+    return sendEventMessage(eventName, eventValue);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const JsonTree& eventValue) {
+    return sendEventMessage(eventName, eventValue);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const EventValue& eventValue) {
+    return sendEventMessage(eventName, eventValue);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const float* values, size_t count) {
+    return sendArrayMessage(eventName, values, count);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const int32_t* values, size_t count) {
+    return sendArrayMessage(eventName, values, count);
+}
+
+SendStatus Lemma::sendMessage(const std::string& eventName, const uint8_t* values, size_t count) {
+    return sendArrayMessage(eventName, values, count);
+}
+
+void Lemma::setFlushWindow(size_t millis) {
+    mWriteQueue->setFlushWindow(millis);
+}
+
+void Lemma::setFlushThreshold(size_t bytes) {
+    mWriteQueue->setFlushThreshold(bytes);
+}
+
+void Lemma::connectHighWatermarkEventHandler(const std::function<void()>& eventHandler) {
+    mWriteQueue->connectHighWatermarkEventHandler(eventHandler);
+}
+
+void Lemma::connectLowWatermarkEventHandler(const std::function<void()>& eventHandler) {
+    mWriteQueue->connectLowWatermarkEventHandler(eventHandler);
+}
+
+void Lemma::setEventPolicy(const std::string& eventName, const EventPolicy& policy) {
+    Symbol symbol = internEventName(eventName);
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    mEventPolicies[symbol] = policy;
 }
 
 void Lemma::begin() {
     if (mConnected) {
         return;
     }
-    setupDiscoveryClient();
+    mTransport = nullptr;
+    mDirectHost.clear();
+    mDirectPort = 0;
+    mBeginTime = std::chrono::steady_clock::now();
+
+    if (!mAppIoService) {
+        getIoService().post([&]() {
+            connect();
+        });
+        return;
+    }
+    connect();
+}
+
+void Lemma::begin(const std::string& host, uint16_t port) {
+    if (mConnected) {
+        return;
+    }
+    mTransport = nullptr;
+    mDirectHost = host;
+    mDirectPort = port;
+    mBeginTime = std::chrono::steady_clock::now();
+
+    if (!mAppIoService) {
+        getIoService().post([&]() {
+            connect();
+        });
+        return;
+    }
+    connect();
+}
+
+void Lemma::begin(const TransportRef& transport) {
+    if (mConnected) {
+        return;
+    }
+    mTransport = transport;
+    mBeginTime = std::chrono::steady_clock::now();
+
+    std::function<void()> open = [&]() {
+        // NB - like registration, hears are fixed once open
+        mTransport->open(mGuestName, getHears(), getIoService(), [&](const boost::string_ref& eventName, const EventValue& eventValue) {
+            receiveEvent(eventName, eventValue);
+        });
+        mConnected = true;
+        mConnectDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - mBeginTime).count();
+    };
+    if (!mAppIoService) {
+        getIoService().post(open);
+        return;
+    }
+    open();
+}
+
+size_t Lemma::poll(size_t maxEvents) {
+    if (!mEventQueue) {
+        return 0;
+    }
+
+    size_t count = 0;
+    QueuedEvent* event = nullptr;
+    while ((maxEvents == 0 || count < maxEvents) && (event = mEventQueue->front())) {
+        double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - event->getEnqueueTime()).count();
+        mQueueStats.totalLatency += latency;
+        mQueueStats.maxLatency = std::max(mQueueStats.maxLatency, latency);
+        mQueueStats.dispatched++;
+
+        dispatchMessageEvent(event->getEventName(), event->getEventValue());
+        mEventQueue->pop();
+        count++;
+    }
+    return count;
+}
+
+const DiscoverySchedule::Stats& Lemma::getDiscoveryStats() const {
+    return mPool ? mPool->getDiscoveryStats() : mDiscovery->getStats();
+}
+
+bool Lemma::isHostResponsive() const {
+    if (!mConnected) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mHeartbeatMutex);
+    // NB - the newest heartbeat may simply still be in flight
+    return !mHeartbeatAcknowledged || mHeartbeatSendTimes.size() <= 1;
+}
+
+SendBuffer::Stats Lemma::getSendBufferStats() const {
+    if (!mSendBuffer) {
+        return SendBuffer::Stats();
+    }
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    return mSendBuffer->getStats();
+}
+
+Lemma::HeartbeatStats Lemma::getHeartbeatStats() const {
+    std::lock_guard<std::mutex> lock(mHeartbeatMutex);
+    return mHeartbeatStats;
+}
+
+Metrics::Snapshot Lemma::getMetrics() const {
+    Metrics::Snapshot snapshot = mMetrics.getSnapshot(mEventNames);
+    // NB - frames are counted by the write queue as they are committed, drops wherever they happen
+    WriteQueue::Snapshot writeQueue = mWriteQueue->getSnapshot();
+    const WriteQueue::Stats& writeStats = writeQueue.stats;
+    snapshot.counters[static_cast<size_t>(Metrics::Counter::FramesOut)] = writeStats.frames;
+    snapshot.counters[static_cast<size_t>(Metrics::Counter::DroppedFrames)] += writeStats.dropped + writeStats.rejected + mDroppedEventCount + (mEventQueue ? mEventQueue->getDroppedCount() : 0);
+    if (mSendBuffer) {
+        SendBuffer::Stats sendBufferStats = getSendBufferStats();
+        snapshot.counters[static_cast<size_t>(Metrics::Counter::DroppedFrames)] += sendBufferStats.dropped + sendBufferStats.expired;
+    }
+    snapshot.writeQueueDepth = writeQueue.pendingFrameCount;
+    snapshot.timeToDiscover = getDiscoveryStats().lastTimeToDiscover;
+    return snapshot;
 }
 
 #pragma mark -
 
 void Lemma::end() {
     mConnected = false;
+    mConnecting = false;
 
-    if (mUDPClientSession && mUDPClientSession->getSocket()->is_open()) {
-        boost::system::error_code err;
-        mUDPClientSession->getSocket()->close(err);
-        if (err) {
-            cinder::app::console() << "ERROR - UDP client session failed to close - " << err << std::endl;
-        }
+    if (mTransport) {
+        mTransport->close();
     }
-    if (mUDPServerSession && mUDPServerSession->getSocket()->is_open()) {
-        boost::system::error_code err;
-        mUDPServerSession->getSocket()->close(err);
-        if (err) {
-            cinder::app::console() << "ERROR - UDP server session failed to close - " << err << std::endl;
-        }
+
+    if (mDiscovery) {
+        mDiscovery->close();
     }
 
+    mWriteQueue->close();
     if (mTCPClientSession && mTCPClientSession->getSocket()->is_open()) {
         mTCPClientSession->close();
     }
     if (mTCPServerSession && mTCPServerSession->getSocket()->is_open()) {
         mTCPServerSession->close();
     }
-}
-
-#pragma mark - DISCOVERY
+    mFrameReader->close();
 
-void Lemma::setupDiscoveryClient() {
-    mAvailabilityBroadcastTimer = WaitTimer::create(ci::app::App::get()->io_service());
-    mAvailabilityBroadcastTimer->connectErrorEventHandler([](std::string message, size_t arg) {
-        cinder::app::console() << "ERROR - availabilty broadcast timer - " << message << " " << arg << std::endl;
-    });
-    mAvailabilityBroadcastTimer->connectWaitEventHandler([&]() {
-        sendAvailabilityBroadcast();
-    });
-
-    mUDPClient = UdpClient::create(ci::app::App::get()->io_service());
-    mUDPClient->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-        cinder::app::console() << "ERROR - UDP client - " << err << std::endl;
-    });
-	mUDPClient->connectConnectEventHandler([&](UdpSessionRef session) {
-        mUDPClientSession = session;
-        mUDPClientSession->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-            cinder::app::console() << "ERROR - UDP client session - " << err << std::endl;
-        });
-        mUDPClientSession->connectWriteEventHandler([](size_t bytesTransferred) {
-            cinder::app::console() << "NOTICE - UDP client session wrote " << bytesTransferred << " bytes" << std::endl;
-        });
-
-        // enable broadcast
-        boost::asio::socket_base::broadcast broadcastOption(true);
-        mUDPClientSession->getSocket()->set_option(broadcastOption);
-
-        // enable address reuse
-        boost::asio::socket_base::reuse_address addressOption(true);
-        boost::system::error_code errorCode;
-        mUDPClientSession->getSocket()->set_option(addressOption, errorCode);
-        if (errorCode) {
-            cinder::app::console() << "ERROR - UDP client session failed to enable address reuse " << errorCode << std::endl;
-        }
-
-        unsigned short localPort = mUDPClientSession->getSocket()->local_endpoint().port();
-        cinder::app::console() << "NOTICE - UDP client session sending from port " << localPort << std::endl;
+    std::lock_guard<std::mutex> lock(mHeartbeatMutex);
+    mHeartbeatSendTimes.clear();
+    mHeartbeatAcknowledged = false;
+    mHeartbeatStats.outstanding = 0;
+}
 
-        setupDiscoveryServer(static_cast<uint16_t>(localPort));
+void Lemma::connect() {
+    if (!mDirectHost.empty()) {
+        setupMessagingClient(mDirectHost, mDirectPort);
+        return;
+    }
 
-        // TODO - wait until server is setup?
-        sendAvailabilityBroadcast();
-    });
-    mUDPClient->connectResolveEventHandler([]() {
-        cinder::app::console() << "NOTICE - UDP client endpoint resolved" << std::endl;
-    });
+    if (mPool) {
+        // the pool tries the host it knows of and discovers on behalf of every lemma still looking
+        mPool->discover(this);
+        return;
+    }
 
-    mUDPClient->connect(sAvailabilityBroadcastHost, sAvailabilityBroadcastPort);
+    // NB - the last known host is usually still there, discovery only matters if it is not
+    if (!mCachedHost.empty()) {
+        NOAM_LOG_NOTICE("trying last known host " << mCachedHost << ":" << mCachedPort);
+        setupMessagingClient(mCachedHost, mCachedPort);
+    }
+    mDiscovery->start(getAvailabilityMessage());
 }
 
-void Lemma::setupDiscoveryServer(uint16_t port) {
-    mUDPServer = UdpServer::create(ci::app::App::get()->io_service());
-    mUDPServer->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-        cinder::app::console() << "ERROR - UDP server - " << err << std::endl;
-    });
-    mUDPServer->connectAcceptEventHandler([&](UdpSessionRef session) {
-        mUDPServerSession = session;
-        mUDPServerSession->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-            cinder::app::console() << "ERROR - UDP server session - " << err << std::endl;
-        });
-        mUDPServerSession->connectReadEventHandler([&](ci::Buffer buffer) {
-            boost::asio::ip::udp::endpoint endpoint = mUDPServerSession->getRemoteEndpoint();
-            std::string response = UdpSession::bufferToString(buffer);
-            cinder::app::console() << "NOTICE - host server response - " << response << "\" from " << endpoint << std::endl;
-            JsonTree data = JsonTree(response);
-            if (data.getNumChildren() != 3) {
-                cinder::app::console() << "ERROR - host server response has an invalid number of children - " << data.getNumChildren() << std::endl;
-            } else {
-                std::string header = data.getValueAtIndex<std::string>(0);
-                if (header != sAvailabilityBroadcastResponseHeader) {
-                    cinder::app::console() << "ERROR - host server response has an unknown header - " << header << std::endl;
-                } else {
-                    std::string room = data.getValueAtIndex<std::string>(1);
-                    uint16_t port = data.getValueAtIndex<uint16_t>(2);
-                    setupMessagingClient(endpoint.address().to_string(), port);
-                }
-            }
-        });
+void Lemma::restartDiscovery() {
+    if (mDiscovery) {
+        mDiscovery->start(getAvailabilityMessage());
+    } else if (mPool) {
+        mPool->rediscover(this, mConnectingHost, mConnectingPort);
+    }
+}
 
-        mUDPServerSession->read();
-    });
+void Lemma::loadHostCache() {
+    if (mFormat.getHostCachePath().empty()) {
+        return;
+    }
 
-    // listen on client send port
-    mUDPServer->accept(port);
-    cinder::app::console() << "NOTICE - UDP server listening on port " << port << std::endl;
+    std::ifstream stream(mFormat.getHostCachePath().string().c_str());
+    std::string host;
+    uint16_t port = 0;
+    if (stream >> host >> port) {
+        mCachedHost = host;
+        mCachedPort = port;
+    }
 }
 
-void Lemma::sendAvailabilityBroadcast() {
-    if (mConnected) {
+void Lemma::saveHostCache() {
+    if (mFormat.getHostCachePath().empty()) {
         return;
     }
 
+    std::ofstream stream(mFormat.getHostCachePath().string().c_str(), std::ios::trunc);
+    stream << mCachedHost << " " << mCachedPort << std::endl;
+    if (!stream) {
+        NOAM_LOG_ERROR("failed to write host cache " << mFormat.getHostCachePath());
+    }
+}
+
+#pragma mark - DISCOVERY
+
+std::string Lemma::getAvailabilityMessage() const {
     JsonTree rootArray = JsonTree::makeArray();
     rootArray.pushBack(JsonTree("", sAvailabilityBroadcastHeader));
     rootArray.pushBack(JsonTree("", mGuestName));
     rootArray.pushBack(JsonTree("", mRoomName));
     rootArray.pushBack(JsonTree("", sLemmaDialect));
     rootArray.pushBack(JsonTree("", sLemmaVersion));
-
-    std::string jsonString = rootArray.serialize();
-    Buffer buffer = UdpSession::stringToBuffer(jsonString);
-    mUDPClientSession->write(buffer);
-
-    mAvailabilityBroadcastTimer->wait(sAvailabilityBroadcastInterval, false);
+    return rootArray.serialize();
 }
 
 #pragma mark - REGISTRATION AND MESSAGING
 
-void Lemma::setupMessagingClient(const std::string& host, uint16_t port) {
-    mHeartbeatTimer = WaitTimer::create(ci::app::App::get()->io_service());
-    mHeartbeatTimer->connectErrorEventHandler([](std::string message, size_t arg) {
-        cinder::app::console() << "ERROR - heartbeat timer - " << message << " " << arg << std::endl;
-    });
-    mHeartbeatTimer->connectWaitEventHandler([&]() {
-        sendHeartbeatMessage();
-    });
+void Lemma::setupMessagingClient(const std::string& host, uint16_t port, bool discovered) {
+    if (mConnected) {
+        return;
+    }
+    if (mConnecting) {
+        // let an attempt in progress play out unless it is stuck, e.g. the last known host went away without a reset, or
+        //  a host just answered where the last known one has yet to, e.g. its address was handed to someone else
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mConnectStartTime).count();
+        bool supersedes = discovered && !mConnectingDiscovered;
+        if ((host == mConnectingHost && port == mConnectingPort) || (elapsed < sConnectTimeout && !supersedes)) {
+            return;
+        }
+        NOAM_LOG_NOTICE("abandoning connection attempt to " << mConnectingHost << ":" << mConnectingPort);
+    }
+    mConnecting = true;
+    mConnectingHost = host;
+    mConnectingPort = port;
+    mConnectingDiscovered = discovered;
+    mConnectStartTime = std::chrono::steady_clock::now();
+
+    mTCPClient = TcpClient::create(getIoService());
+    TcpClient* client = mTCPClient.get();
+    mTCPClient->connectErrorEventHandler([&, client](std::string err, size_t bytesTransferred) {
+        NOAM_LOG_ERROR("TCP client - " << err);
+        if (client != mTCPClient.get() || mConnected) {
+            return;
+        }
 
-    mTCPClient = TcpClient::create(ci::app::App::get()->io_service());
-    mTCPClient->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-        cinder::app::console() << "ERROR - TCP client - " << err << std::endl;
+        // failed to reach the host, discovery carries on in the background unless connecting directly
+        mConnecting = false;
+        if (mDirectHost.empty() && !mConnectingDiscovered) {
+            // NB - the last known host is gone, any answer to the broadcasts so far was passed over while trying it
+            restartDiscovery();
+        } else if (!mDirectHost.empty()) {
+            if (!mReconnectTimer) {
+                mReconnectTimer = WaitTimer::create(getIoService());
+                mReconnectTimer->connectWaitEventHandler([&]() {
+                    connect();
+                });
+            }
+            mReconnectTimer->wait(sReconnectInterval, false);
+        }
     });
-    mTCPClient->connectConnectEventHandler([&](TcpSessionRef session) {
+    mTCPClient->connectConnectEventHandler([&, client](TcpSessionRef session) {
+        if (client != mTCPClient.get() || mConnected) {
+            // superseded by a later attempt
+            session->close();
+            return;
+        }
+
         mTCPClientSession = session;
         mTCPClientSession->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-            cinder::app::console() << "ERROR - TCP client session - " << err << std::endl;
+            NOAM_LOG_ERROR("TCP client session - " << err);
         });
         mTCPClientSession->connectCloseEventHandler([]() {
-            cinder::app::console() << "NOTICE - TCP client session closed" << std::endl;
-        });
-        mTCPClientSession->connectWriteEventHandler([](size_t bytesTransferred) {
-            cinder::app::console() << "NOTICE - TCP client session wrote " << bytesTransferred << " bytes" << std::endl;
+            NOAM_LOG_NOTICE("TCP client session closed");
         });
 
+        // NB - writes go through the queue straight to the socket, one in flight at a time
+        mWriteQueue->open(mTCPClientSession->getSocket());
+
         // NB - apparently do not need to enable address reuse
 
         unsigned short localPort = mTCPClientSession->getSocket()->local_endpoint().port();
-        cinder::app::console() << "NOTICE - TCP client session sending from port " << localPort << std::endl;
+        NOAM_LOG_NOTICE("TCP client session sending from port " << localPort);
 
         setupMessagingServer(localPort);
 
         // TODO - wait until server is setup?
         mConnected = true;
+        mConnecting = false;
+        if (mDiscovery) {
+            mDiscovery->stop();
+        } else if (mPool) {
+            mPool->handleConnect(this, mConnectingHost, mConnectingPort);
+        }
+        mConnectDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - mBeginTime).count();
+        if (mCachedHost != mConnectingHost || mCachedPort != mConnectingPort) {
+            mCachedHost = mConnectingHost;
+            mCachedPort = mConnectingPort;
+            saveHostCache();
+        }
         sendRegistrationMessage();
+        replaySendBuffer();
         sendHeartbeatMessage();
+        if (mHeartbeatTimer && !mHeartbeating) {
+            mHeartbeating = true;
+            mHeartbeatTimer->wait(sHeartbeatInterval, true);
+        }
     });
     mTCPClient->connectResolveEventHandler([]() {
-        cinder::app::console() << "NOTICE - TCP client endpoint resolved" << std::endl;
+        NOAM_LOG_NOTICE("TCP client endpoint resolved");
     });
 
     mTCPClient->connect(host, port);
 }
 
 void Lemma::setupMessagingServer(uint16_t port) {
-    mTCPServer = TcpServer::create(ci::app::App::get()->io_service());
+    mTCPServer = TcpServer::create(getIoService());
     mTCPServer->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-        cinder::app::console() << "ERROR - TCP server - " << err << std::endl;
+        NOAM_LOG_ERROR("TCP server - " << err);
     });
     mTCPServer->connectCancelEventHandler([]() {
-        cinder::app::console() << "NOTICE - TCP server canceled" << std::endl;
+        NOAM_LOG_NOTICE("TCP server canceled");
     });
     mTCPServer->connectAcceptEventHandler([&](TcpSessionRef session) {
         mTCPServerSession = session;
         mTCPServerSession->connectErrorEventHandler([](std::string err, size_t bytesTransferred) {
-            cinder::app::console() << "ERROR - TCP server session - " << err << std::endl;
+            NOAM_LOG_ERROR("TCP server session - " << err);
         });
         mTCPServerSession->connectCloseEventHandler([]() {
-            cinder::app::console() << "NOTICE - TCP server session closed" << std::endl;
+            NOAM_LOG_NOTICE("TCP server session closed");
         });
-        mTCPServerSession->connectReadEventHandler([&](ci::Buffer buffer) {
-            // NB - multiple messages can be received at once. Could occur on OS X Mavericks+ via Timer Coalescing
-            //  see Cinder-AppNap https://github.com/pizthewiz/Cinder-AppNap to tweak Timer Coalescing behavior
-
-            size_t offset = 0;
-            bool status = true;
-            while (status) {
-                // message length stored in the first 6 bytes
-                std::string messageLengthString = std::string(static_cast<const char*>((char*)buffer.getData() + offset), 6);
-                size_t messageLength = fromString<size_t>(messageLengthString);
-                offset += 6;
-
-                // verify length
-                if (messageLength > buffer.getDataSize() - offset) {
-                    cinder::app::console() << "ERROR - message length " << messageLength << " larger than remaining buffer data length " << (buffer.getDataSize() - offset) << std::endl;
-                    status = false;
-                } else {
-                    // parse and process message
-                    std::string messageString = std::string(static_cast<const char*>((char*)buffer.getData() + offset), messageLength);
-                    JsonTree message = JsonTree(messageString);
-                    std::string header = message[0].getValue<std::string>();
-                    if (header != sEventMessageHeader && header != sHeartbeatAckHeader) {
-                        cinder::app::console() << "ERROR - bad event message header \"" << header << "\"" << std::endl;
-                    } else if (header == sHeartbeatAckHeader) {
-                        // heartbeat ack, ignore for now 👍
-                    } else if (header != sEventMessageHeader) {
-                        cinder::app::console() << "ERROR - bad event message header \"" << header << "\"" << std::endl;
-                    } else {
-                        std::string guestName = message[1].getValue<std::string>();
-                        std::string eventName = message[2].getValue<std::string>();
-                        std::string eventValue;
-                        if (message[3].getNodeType() != JsonTree::NODE_VALUE) {
-                            JsonTree object = message[3];
-                            eventValue = object.serialize();
-                        } else {
-                            eventValue = message[3].getValue<std::string>();
-                        }
-
-                        // dispatch message
-                        if (mMessageEventHandlerMap.count(eventName)) {
-                            std::function<void(const std::string&, const std::string&)> eventHandler = mMessageEventHandlerMap[eventName];
-                            eventHandler(eventName, eventValue);
-                        }
-                    }
-
-                    offset += messageLength;
-                    if (offset + 6 >= buffer.getDataSize()) {
-                        status = false;
-                    }
-                }
+        // NB - read straight into the frame reader rather than through the session
+        mFrameReader->open(mTCPServerSession->getSocket());
+    });
+
+    // listen on client send port
+    mTCPServer->accept(port);
+    NOAM_LOG_NOTICE("TCP server listening on port " << port);
+}
+
+void Lemma::handleMessage(const boost::string_ref& receivedFrame) {
+    boost::string_ref frame = receivedFrame;
+    if (!frame.empty() && frame[0] == Compressor::sFrameMarker) {
+        if (!mDecompressor.decompress(frame.data() + 1, frame.size() - 1)) {
+            NOAM_LOG_ERROR("failed to decompress message");
+            mMetrics.increment(Metrics::Counter::ParseErrors);
+            return;
+        }
+        frame = boost::string_ref(mDecompressor.getData(), mDecompressor.getSize());
+    }
+
+    if (!mMessageParser.parse(frame)) {
+        NOAM_LOG_ERROR("failed to parse message - " << mMessageParser.getError());
+        mMetrics.increment(Metrics::Counter::ParseErrors);
+        return;
+    }
+    mMetrics.trace(Metrics::Trace::Parse, mMessageParser.getEventName(), frame.size());
+
+    boost::string_ref header = mMessageParser.getHeader();
+    if (header == sHeartbeatAckHeader) {
+        receiveHeartbeatAck();
+    } else if (header == sCompressionHeader) {
+        // NB - the host only agrees to what was advertised at registration
+        NOAM_LOG_NOTICE("host accepted compression");
+        mWriteQueue->setCompressionThreshold(mFormat.getCompressionThreshold());
+    } else if (!mMessageParser.isEvent()) {
+        NOAM_LOG_ERROR("bad event message header \"" << header << "\"");
+    } else {
+        receiveEvent(mMessageParser.getEventName(), mMessageParser.getEventValue());
+    }
+}
+
+void Lemma::receiveEvent(const boost::string_ref& eventName, const EventValue& eventValue) {
+    // dispatch message, or queue it for poll() when threaded
+    if (!mEventQueue) {
+        dispatchMessageEvent(eventName, eventValue);
+    } else if (hasMessageEventHandler(eventName)) {
+        if (!mEventQueue->push(eventName, eventValue)) {
+            NOAM_LOG_ERROR("event queue full, dropping event \"" << eventName << "\"");
+            return;
+        }
+        mMetrics.trace(Metrics::Trace::Enqueue, eventName);
+    }
+}
+
+std::vector<std::string> Lemma::getHears() const {
+    // NB - registration happens on the I/O thread
+    std::shared_ptr<const HeardEvents> heardEvents = std::atomic_load(&mHeardEvents);
+    std::vector<std::string> hears;
+    hears.reserve(heardEvents->eventNames.size());
+    for (Symbol symbol = 0; symbol < heardEvents->eventNames.size(); symbol++) {
+        hears.push_back(heardEvents->eventNames.getName(symbol));
+    }
+    return hears;
+}
+
+Symbol Lemma::internEventName(const std::string& eventName) {
+    Symbol symbol = mEventNames.intern(eventName);
+    if (symbol >= mMessageEventHandlers.size()) {
+        mMessageEventHandlers.resize(symbol + 1);
+        // NB - policies are read by senders, on whichever thread, under the write queue's lock
+        std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+        mEventPolicies.resize(symbol + 1);
+    }
+    return symbol;
+}
+
+void Lemma::publishHeardEvents() {
+    // NB - copy on write, the I/O thread keeps using the set it loaded
+    std::shared_ptr<HeardEvents> heardEvents = std::make_shared<HeardEvents>();
+    for (Symbol symbol = 0; symbol < mEventNames.size(); symbol++) {
+        for (const auto& entry : mMessageEventHandlers[symbol]) {
+            if (entry.id != 0) {
+                heardEvents->eventNames.intern(mEventNames.getName(symbol));
+                break;
             }
+        }
+    }
+    for (const auto& entry : mPrefixMessageEventHandlers) {
+        if (entry.id != 0) {
+            heardEvents->prefixes.push_back(entry.prefix);
+        }
+    }
+    std::atomic_store(&mHeardEvents, std::shared_ptr<const HeardEvents>(heardEvents));
+}
 
-            mTCPServerSession->read();
-        });
-        mTCPServerSession->connectReadCompleteEventHandler([&]() {
-            cinder::app::console() << "NOTICE - TCP server session read complete" << std::endl;
+bool Lemma::hasMessageEventHandler(const boost::string_ref& eventName) const {
+    std::shared_ptr<const HeardEvents> heardEvents = std::atomic_load(&mHeardEvents);
+    if (heardEvents->eventNames.find(eventName) != sInvalidSymbol) {
+        return true;
+    }
+    for (const std::string& prefix : heardEvents->prefixes) {
+        if (eventName.starts_with(prefix)) {
+            return true;
+        }
+    }
+    return false;
+}
 
-            // occurs when fired by the host server or the host server dies, go back into discovery mode
-            end();
-            begin();
-        });
+void Lemma::dispatchMessageEvent(const boost::string_ref& eventName, const EventValue& eventValue) {
+    mDispatching = true;
+    std::chrono::steady_clock::time_point dispatchTime = std::chrono::steady_clock::now();
+
+    // NB - a single hash of the received name, the interned name doubles as the handler argument
+    const std::string* name = nullptr;
+    Symbol symbol = mEventNames.find(eventName);
+    if (symbol != sInvalidSymbol) {
+        name = &mEventNames.getName(symbol);
+        // indexed, a handler may add handlers and grow the tables
+        for (size_t idx = 0; idx < mMessageEventHandlers[symbol].size(); idx++) {
+            if (mMessageEventHandlers[symbol][idx].id != 0) {
+                mMessageEventHandlers[symbol][idx].handler(*name, eventValue);
+            }
+        }
+    }
 
-        mTCPServerSession->read();
-    });
+    for (size_t idx = 0; idx < mPrefixMessageEventHandlers.size(); idx++) {
+        if (mPrefixMessageEventHandlers[idx].id == 0 || !eventName.starts_with(mPrefixMessageEventHandlers[idx].prefix)) {
+            continue;
+        }
+        if (!name) {
+            mEventName.assign(eventName.data(), eventName.size());
+            name = &mEventName;
+        }
+        mPrefixMessageEventHandlers[idx].handler(*name, eventValue);
+    }
 
-    // listen on client send port
-    mTCPServer->accept(port);
-    cinder::app::console() << "NOTICE - TCP server listening on port " << port << std::endl;
+    uint64_t duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - dispatchTime).count();
+    mMetrics.getDispatchHistogram(symbol).record(duration);
+    mMetrics.trace(Metrics::Trace::Dispatch, eventName, static_cast<size_t>(duration));
+
+    mDispatching = false;
+    if (mHandlerRemovalPending) {
+        mHandlerRemovalPending = false;
+        for (auto& handlers : mMessageEventHandlers) {
+            handlers.erase(std::remove_if(handlers.begin(), handlers.end(), [](const MessageEventHandler& entry) { return entry.id == 0; }), handlers.end());
+        }
+        mPrefixMessageEventHandlers.erase(std::remove_if(mPrefixMessageEventHandlers.begin(), mPrefixMessageEventHandlers.end(), [](const PrefixMessageEventHandler& entry) { return entry.id == 0; }), mPrefixMessageEventHandlers.end());
+    }
 }
 
 void Lemma::sendRegistrationMessage() {
@@ -369,8 +800,8 @@ void Lemma::sendRegistrationMessage() {
     unsigned short port = mTCPClientSession->getSocket()->local_endpoint().port();
     rootArray.pushBack(JsonTree("", port));
     JsonTree hearsArray = JsonTree::makeArray();
-    for (const auto& kv : mMessageEventHandlerMap) {
-        hearsArray.pushBack(JsonTree("", kv.first));
+    for (const std::string& eventName : getHears()) {
+        hearsArray.pushBack(JsonTree("", eventName));
     }
     rootArray.pushBack(hearsArray);
     JsonTree speaksArray = JsonTree::makeArray();
@@ -379,59 +810,298 @@ void Lemma::sendRegistrationMessage() {
     rootArray.pushBack(JsonTree("", sLemmaVersion));
     JsonTree optionsObject = JsonTree::makeObject();
     optionsObject.pushBack(JsonTree("heartbeat", (int)sHeartbeatInterval / 1000));
-//    optionsObject.pushBack(JsonTree("heartbeat_ack", true));
+    optionsObject.pushBack(JsonTree("heartbeat_ack", true));
+    if (Compressor::isAvailable() && mFormat.getCompressionThreshold()) {
+        optionsObject.pushBack(JsonTree("compression", std::string(Compressor::getName())));
+    }
     rootArray.pushBack(optionsObject);
     sendJSON(rootArray);
 }
 
 void Lemma::sendHeartbeatMessage() {
-    if (!mConnected) {
+    if (!mConnected || mTransport) {
         return;
     }
 
-    JsonTree rootArray = JsonTree::makeArray();
-    rootArray.pushBack(JsonTree("", sHeartbeatHeader));
-    rootArray.pushBack(JsonTree("", mGuestName));
-    sendJSON(rootArray);
+    size_t maxMissed = mFormat.getMaxMissedHeartbeats();
+    {
+        std::lock_guard<std::mutex> lock(mHeartbeatMutex);
+        if (maxMissed && mHeartbeatAcknowledged && mHeartbeatSendTimes.size() >= maxMissed) {
+            mHeartbeatStats.deadHosts++;
+            NOAM_LOG_ERROR("host missed " << mHeartbeatSendTimes.size() << " heartbeats, reconnecting");
+        } else {
+            maxMissed = 0;
+        }
+    }
+    if (maxMissed) {
+        // the connection is still up yet the host is gone, waiting on TCP to notice can take minutes
+        mMetrics.increment(Metrics::Counter::Reconnects);
+        end();
+        mBeginTime = std::chrono::steady_clock::now();
+        connect();
+        return;
+    }
 
-    mHeartbeatTimer->wait(sHeartbeatInterval, false);
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = mWriteQueue->getEncoder();
+    encoder.beginFrame();
+    encoder.appendRaw('[');
+    encoder.appendString(sHeartbeatHeader);
+    encoder.appendRaw(',');
+    encoder.appendRaw(mQuotedGuestName);
+    encoder.appendRaw(']');
+    encoder.endFrame();
+    // NB - ahead of any queued events, stuck behind a burst of them the host could take us for dead
+    mWriteQueue->commit(0, Lane::Control);
+
+    std::lock_guard<std::mutex> heartbeatLock(mHeartbeatMutex);
+    // NB - hosts that never ack would only grow this
+    if (!mHeartbeatAcknowledged && mHeartbeatSendTimes.size() >= sMaxUnacknowledgedHeartbeats) {
+        mHeartbeatSendTimes.pop_front();
+    }
+    mHeartbeatSendTimes.push_back(std::chrono::steady_clock::now());
+    mHeartbeatStats.sent++;
+    mHeartbeatStats.outstanding = mHeartbeatSendTimes.size();
 }
 
-template<typename T>
-void Lemma::sendEventMessage(const std::string& eventName, T eventValue) {
-    if (!mConnected) {
+void Lemma::receiveHeartbeatAck() {
+    // NB - hosts only ack when asked to at registration
+    std::lock_guard<std::mutex> lock(mHeartbeatMutex);
+    if (mHeartbeatSendTimes.empty()) {
+        NOAM_LOG_ERROR("unexpected heartbeat ack");
         return;
     }
 
-    JsonTree rootArray = JsonTree::makeArray();
-    rootArray.pushBack(JsonTree("", sEventMessageHeader));
-    rootArray.pushBack(JsonTree("", mGuestName));
-    rootArray.pushBack(JsonTree("", eventName));
-    rootArray.pushBack(JsonTree("", eventValue));
-    sendJSON(rootArray);
+    std::chrono::steady_clock::duration roundTrip = std::chrono::steady_clock::now() - mHeartbeatSendTimes.front();
+    mHeartbeatSendTimes.pop_front();
+    mHeartbeatAcknowledged = true;
+    mMetrics.getHeartbeatHistogram().record(std::chrono::duration_cast<std::chrono::microseconds>(roundTrip).count());
+
+    double seconds = std::chrono::duration<double>(roundTrip).count();
+    // exponentially weighted as TCP does, 1/8 of each new sample
+    mHeartbeatStats.roundTripTime = mHeartbeatStats.acknowledged ? mHeartbeatStats.roundTripTime + (seconds - mHeartbeatStats.roundTripTime) / 8.0 : seconds;
+    mHeartbeatStats.lastRoundTripTime = seconds;
+    mHeartbeatStats.acknowledged++;
+    mHeartbeatStats.outstanding = mHeartbeatSendTimes.size();
 }
 
-void Lemma::sendEventMessage(const std::string& eventName, const JsonTree& eventValue) {
-    // NB - duplicated from above without wrapping eventValue in a JsonTree
-    //  couldn't sort out how to RTT it with a single method
-    if (!mConnected) {
+template<typename T>
+SendStatus Lemma::sendEventMessage(const std::string& eventName, const T& eventValue) {
+    if (!mConnected && (!mSendBuffer || mTransport)) {
+        mDroppedEventCount++;
+        return SendStatus::Rejected;
+    }
+    if (mTransport) {
+        mTransport->send(eventName, makeEventValue(eventValue));
+        mMetrics.trace(Metrics::Trace::Send, eventName);
+        return SendStatus::Accepted;
+    }
+
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = getEventEncoder();
+    encoder.beginEventFrame(mQuotedGuestName, eventName);
+    encoder.appendValue(eventValue);
+    encoder.endEventFrame();
+    if (!encoder.endFrame()) {
+        NOAM_LOG_ERROR("event message \"" << eventName << "\" exceeds the maximum message length");
+        return SendStatus::Rejected;
+    }
+    return commitEventFrame(eventName, encoder);
+}
+
+SendStatus Lemma::sendEventMessage(const std::string& eventName, const JsonTree& eventValue) {
+    if (!mConnected && (!mSendBuffer || mTransport)) {
+        mDroppedEventCount++;
+        return SendStatus::Rejected;
+    }
+    if (mTransport) {
+        // NB - a tree has no typed form, its JSON is read back into a value
+        std::string json = eventValue.serialize();
+        JsonReader reader;
+        reader.reset(json);
+        EventValue value;
+        if (!reader.readValue(value)) {
+            NOAM_LOG_ERROR("event message \"" << eventName << "\" is not valid JSON - " << reader.getError());
+            return SendStatus::Rejected;
+        }
+        mTransport->send(eventName, value);
+        mMetrics.trace(Metrics::Trace::Send, eventName);
+        return SendStatus::Accepted;
+    }
+
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = getEventEncoder();
+    encoder.beginEventFrame(mQuotedGuestName, eventName);
+    encoder.appendRaw(eventValue.serialize());
+    encoder.endEventFrame();
+    if (!encoder.endFrame()) {
+        NOAM_LOG_ERROR("event message \"" << eventName << "\" exceeds the maximum message length");
+        return SendStatus::Rejected;
+    }
+    return commitEventFrame(eventName, encoder);
+}
+
+SendStatus Lemma::sendEventMessage(const std::string& eventName, const EventValue& eventValue) {
+    if (!mConnected && (!mSendBuffer || mTransport)) {
+        mDroppedEventCount++;
+        return SendStatus::Rejected;
+    }
+    if (mTransport) {
+        mTransport->send(eventName, eventValue);
+        mMetrics.trace(Metrics::Trace::Send, eventName);
+        return SendStatus::Accepted;
+    }
+
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = getEventEncoder();
+    encoder.beginEventFrame(mQuotedGuestName, eventName);
+    encoder.appendValue(eventValue);
+    encoder.endEventFrame();
+    if (!encoder.endFrame()) {
+        NOAM_LOG_ERROR("event message \"" << eventName << "\" exceeds the maximum message length");
+        return SendStatus::Rejected;
+    }
+    return commitEventFrame(eventName, encoder);
+}
+
+SendStatus Lemma::sendFieldsMessage(const std::string& eventName, void (*encodeValue)(FrameEncoder&, const void*), const void* eventValue) {
+    if (!mConnected && (!mSendBuffer || mTransport)) {
+        mDroppedEventCount++;
+        return SendStatus::Rejected;
+    }
+    if (mTransport) {
+        // NB - like a tree, the object is encoded and read back into a value
+        FrameEncoder encoder(256);
+        encodeValue(encoder, eventValue);
+        JsonReader reader;
+        reader.reset(boost::string_ref(encoder.getData(), encoder.getSize()));
+        EventValue value;
+        if (!reader.readValue(value)) {
+            NOAM_LOG_ERROR("event message \"" << eventName << "\" is not valid JSON - " << reader.getError());
+            return SendStatus::Rejected;
+        }
+        mTransport->send(eventName, value);
+        mMetrics.trace(Metrics::Trace::Send, eventName);
+        return SendStatus::Accepted;
+    }
+
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = getEventEncoder();
+    encoder.beginEventFrame(mQuotedGuestName, eventName);
+    encodeValue(encoder, eventValue);
+    encoder.endEventFrame();
+    if (!encoder.endFrame()) {
+        NOAM_LOG_ERROR("event message \"" << eventName << "\" exceeds the maximum message length");
+        return SendStatus::Rejected;
+    }
+    return commitEventFrame(eventName, encoder);
+}
+
+template<typename T>
+SendStatus Lemma::sendArrayMessage(const std::string& eventName, const T* values, size_t count) {
+    if (!mConnected && (!mSendBuffer || mTransport)) {
+        mDroppedEventCount++;
+        return SendStatus::Rejected;
+    }
+    bool binary = isBinary(eventName);
+    if (mTransport) {
+        // NB - the receiving end decodes either encoding, a transport gets the value as it would be on the wire
+        FrameEncoder encoder(binary ? Base64::getEncodedSize(count * sizeof(T)) + 32 : count * 8 + 2);
+        if (binary) {
+            encoder.appendBinary(values, count);
+        } else {
+            encoder.appendArray(values, count);
+        }
+        JsonReader reader;
+        reader.reset(boost::string_ref(encoder.getData(), encoder.getSize()));
+        EventValue value;
+        if (!reader.readValue(value)) {
+            NOAM_LOG_ERROR("event message \"" << eventName << "\" is not valid JSON - " << reader.getError());
+            return SendStatus::Rejected;
+        }
+        mTransport->send(eventName, value);
+        mMetrics.trace(Metrics::Trace::Send, eventName);
+        return SendStatus::Accepted;
+    }
+
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = getEventEncoder();
+    encoder.beginEventFrame(mQuotedGuestName, eventName);
+    if (binary) {
+        encoder.appendBinary(values, count);
+    } else {
+        encoder.appendArray(values, count);
+    }
+    encoder.endEventFrame();
+    if (!encoder.endFrame()) {
+        NOAM_LOG_ERROR("event message \"" << eventName << "\" exceeds the maximum message length");
+        return SendStatus::Rejected;
+    }
+    return commitEventFrame(eventName, encoder);
+}
+
+FrameEncoder& Lemma::getEventEncoder() {
+    // NB - while anything is still buffered, new events queue up behind it rather than overtake it
+    if (mSendBuffer && (!mConnected || !mSendBuffer->isEmpty())) {
+        mSendBufferEncoder.clear();
+        return mSendBufferEncoder;
+    }
+    return mWriteQueue->getEncoder();
+}
+
+SendStatus Lemma::commitEventFrame(const std::string& eventName, FrameEncoder& encoder) {
+    mMetrics.trace(Metrics::Trace::Send, eventName, encoder.getSize() - encoder.getFrameOffset());
+    Symbol symbol = mEventNames.find(eventName);
+    // NB - a name being interned on another thread may not have its policy yet
+    const EventPolicy& policy = symbol < mEventPolicies.size() ? mEventPolicies[symbol] : EventPolicy();
+    if (&encoder != &mSendBufferEncoder) {
+        return mWriteQueue->commit(policy.isConflated() ? symbol + 1 : 0, policy.getLane(), true);
+    }
+
+    // the frame is prefixed again when replayed, only its JSON is kept
+    uint64_t conflated = mSendBuffer->getStats().conflated;
+    if (!mSendBuffer->push(eventName, policy.isConflated(), policy.getPriority(), policy.getTimeToLive(), encoder.getData() + FrameDecoder::sPrefixLength, encoder.getSize() - FrameDecoder::sPrefixLength)) {
+        return SendStatus::Rejected;
+    }
+    return mSendBuffer->getStats().conflated != conflated ? SendStatus::Conflated : SendStatus::Accepted;
+}
+
+void Lemma::replaySendBuffer() {
+    if (!mSendBuffer) {
         return;
     }
 
-    JsonTree rootArray = JsonTree::makeArray();
-    rootArray.pushBack(JsonTree("", sEventMessageHeader));
-    rootArray.pushBack(JsonTree("", mGuestName));
-    rootArray.pushBack(JsonTree("", eventName));
-    rootArray.pushBack(eventValue);
-    sendJSON(rootArray);
+    // NB - committed in one go right behind the registration, they are gathered into as few writes as the queue allows.
+    //  Interactive, as bulk events sent from now on have to queue up behind them and interactive ones keep their order
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    if (!mSendBuffer->isEmpty()) {
+        NOAM_LOG_NOTICE("replaying " << mSendBuffer->getCount() << " buffered events");
+    }
+    FrameEncoder& encoder = mWriteQueue->getEncoder();
+    mSendBuffer->drain([&](const char* data, size_t size) {
+        encoder.beginFrame();
+        encoder.appendRaw(data, size);
+        encoder.endFrame();
+        mWriteQueue->commit();
+    });
+}
+
+bool Lemma::isBinary(const std::string& eventName) const {
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    Symbol symbol = mEventNames.find(eventName);
+    return symbol < mEventPolicies.size() && mEventPolicies[symbol].isBinary();
 }
 
 void Lemma::sendJSON(const JsonTree& root) {
-    std::string jsonString = root.serialize();
-    Buffer jsonBuffer = TcpSession::stringToBuffer(jsonString);
-    std::string dataString = str(boost::format("%06d") % jsonBuffer.getDataSize()) + jsonString;
-    Buffer dataBuffer = TcpSession::stringToBuffer(dataString);
-    mTCPClientSession->write(dataBuffer);
+    std::lock_guard<std::mutex> lock(mWriteQueue->getMutex());
+    FrameEncoder& encoder = mWriteQueue->getEncoder();
+    encoder.beginFrame();
+    encoder.appendRaw(root.serialize());
+    if (!encoder.endFrame()) {
+        NOAM_LOG_ERROR("message exceeds the maximum message length");
+        return;
+    }
+    mWriteQueue->commit(0, Lane::Control);
 }
 
 }}
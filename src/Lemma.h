@@ -9,78 +9,365 @@
 #pragma once
 
 #include "WaitTimer.h"
-#include "UdpClient.h"
-#include "UdpServer.h"
 #include "TcpClient.h"
 #include "TcpServer.h"
+#include "FrameReader.h"
+#include "MessageParser.h"
+#include "WriteQueue.h"
+#include "SendBuffer.h"
+#include "EventQueue.h"
+#include "Fields.h"
+#include "SymbolTable.h"
+#include "Discovery.h"
+#include "Transport.h"
+#include "Metrics.h"
+#include "IoServicePool.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include "cinder/Json.h"
+#include "cinder/Filesystem.h"
 
 namespace Cinder { namespace Noam {
 
 using namespace ci;
 
 typedef std::shared_ptr<class Lemma> LemmaRef;
+class LemmaPool;
 
 class Lemma : public std::enable_shared_from_this<Lemma> {
 public:
-    static LemmaRef create(const std::string& guestName, const std::string& roomName = "");
+    class Format {
+    public:
+        Format() : mThreaded(false), mIoService(nullptr), mEventQueueCapacity(1024), mCompressionThreshold(512), mMaxMissedHeartbeats(3), mSendBuffered(false), mSendBudgetBytes(4 * 1024 * 1024), mSendBudgetFrames(0), mLowWatermark(0), mHighWatermark(0) {}
+
+        // last known host endpoint is kept here across runs, it is tried right away on begin()
+        Format& hostCachePath(const fs::path& path) { mHostCachePath = path; return *this; }
+        inline const fs::path& getHostCachePath() const { return mHostCachePath; }
+
+        // networking runs on a dedicated thread, received events wait in a queue until poll() dispatches them
+        Format& threaded(bool threaded = true) { mThreaded = threaded; return *this; }
+        // networking runs on this io_service rather than the app's, on whichever threads run it. When threaded too, the
+        //  lemma does not start a thread of its own yet received events still wait for poll()
+        Format& ioService(boost::asio::io_service& io) { mIoService = &io; return *this; }
+        // events received beyond this many undispatched ones are dropped
+        Format& eventQueueCapacity(size_t capacity) { mEventQueueCapacity = capacity; return *this; }
+        // how often to broadcast availability while no host has responded
+        Format& discoverySchedule(const DiscoverySchedule::Format& format) { mDiscoveryScheduleFormat = format; return *this; }
+        // frames at least this long are deflated, if built with NOAM_ENABLE_COMPRESSION and the host supports it. 0 never
+        Format& compressionThreshold(size_t bytes) { mCompressionThreshold = bytes; return *this; }
+        // the host is taken for dead, and reconnected to, once this many heartbeats in a row go unacknowledged. 0 never
+        Format& maxMissedHeartbeats(size_t count) { mMaxMissedHeartbeats = count; return *this; }
+        // events sent without a host are kept rather than dropped and replayed once registered. Pooled lemmas each need
+        //  a path of their own
+        Format& sendBuffer(const SendBuffer::Format& format = SendBuffer::Format()) { mSendBuffered = true; mSendBufferFormat = format; return *this; }
+        // events are rejected while this many bytes, or frames, are already queued or being written to the host. 0 for no
+        //  limit, the default is 4 MB and any number of frames
+        Format& sendBudget(size_t bytes, size_t frames = 0) { mSendBudgetBytes = bytes; mSendBudgetFrames = frames; return *this; }
+        // queued bytes at which the high watermark handler is called and, once past it, drained down to for the low one
+        Format& sendWatermarks(size_t lowBytes, size_t highBytes) { mLowWatermark = lowBytes; mHighWatermark = highBytes; return *this; }
+
+        inline bool isThreaded() const { return mThreaded; }
+        inline boost::asio::io_service* getIoService() const { return mIoService; }
+        inline size_t getEventQueueCapacity() const { return mEventQueueCapacity; }
+        inline const DiscoverySchedule::Format& getDiscoveryScheduleFormat() const { return mDiscoveryScheduleFormat; }
+        inline size_t getCompressionThreshold() const { return mCompressionThreshold; }
+        inline size_t getMaxMissedHeartbeats() const { return mMaxMissedHeartbeats; }
+        inline bool isSendBuffered() const { return mSendBuffered; }
+        inline const SendBuffer::Format& getSendBufferFormat() const { return mSendBufferFormat; }
+        inline size_t getSendBudgetBytes() const { return mSendBudgetBytes; }
+        inline size_t getSendBudgetFrames() const { return mSendBudgetFrames; }
+        inline size_t getLowWatermark() const { return mLowWatermark; }
+        inline size_t getHighWatermark() const { return mHighWatermark; }
+
+    private:
+        bool mThreaded;
+        boost::asio::io_service* mIoService;
+        size_t mEventQueueCapacity;
+        fs::path mHostCachePath;
+        DiscoverySchedule::Format mDiscoveryScheduleFormat;
+        size_t mCompressionThreshold;
+        size_t mMaxMissedHeartbeats;
+        bool mSendBuffered;
+        SendBuffer::Format mSendBufferFormat;
+        size_t mSendBudgetBytes;
+        size_t mSendBudgetFrames;
+        size_t mLowWatermark;
+        size_t mHighWatermark;
+    };
+
+    struct QueueStats {
+        QueueStats() : dispatched(0), dropped(0), totalLatency(0.0), maxLatency(0.0) {}
+        inline double getAverageLatency() const { return dispatched ? totalLatency / dispatched : 0.0; }
+
+        uint64_t dispatched;
+        uint64_t dropped;
+        // seconds between enqueue on the I/O thread and dispatch from poll()
+        double totalLatency;
+        double maxLatency;
+    };
+
+    struct HeartbeatStats {
+        HeartbeatStats() : sent(0), acknowledged(0), outstanding(0), roundTripTime(0.0), lastRoundTripTime(0.0), deadHosts(0) {}
+
+        uint64_t sent;
+        uint64_t acknowledged;
+        // sent since the last acknowledgement on the current connection
+        size_t outstanding;
+        // seconds, smoothed over recent acknowledgements
+        double roundTripTime;
+        double lastRoundTripTime;
+        // connections given up on for want of acknowledgements
+        uint64_t deadHosts;
+    };
+
+    class EventPolicy {
+    public:
+        EventPolicy() : mConflated(false), mBinary(false), mPriority(0), mTimeToLive(0), mLane(Lane::Interactive) {}
+
+        // only the newest unsent value matters, it replaces an older one still waiting to be written
+        EventPolicy& conflate(bool conflate = true) { mConflated = conflate; return *this; }
+        // arrays are sent base64 encoded with the binary extension rather than as JSON, only for receivers supporting it
+        EventPolicy& binary(bool binary = true) { mBinary = binary; return *this; }
+        // while send buffered without a host, events of higher priority are kept over lower ones
+        EventPolicy& priority(int priority) { mPriority = priority; return *this; }
+        // milliseconds a send buffered event is still worth replaying, 0 for ever
+        EventPolicy& timeToLive(size_t millis) { mTimeToLive = millis; return *this; }
+        // bulk events are written behind interactive ones, heartbeats always go first
+        EventPolicy& lane(Lane lane) { mLane = lane; return *this; }
+        inline bool isConflated() const { return mConflated; }
+        inline bool isBinary() const { return mBinary; }
+        inline int getPriority() const { return mPriority; }
+        inline size_t getTimeToLive() const { return mTimeToLive; }
+        inline Lane getLane() const { return mLane; }
+
+    private:
+        bool mConflated;
+        bool mBinary;
+        int mPriority;
+        size_t mTimeToLive;
+        Lane mLane;
+    };
+
+    // milliseconds between heartbeats, advertised at registration
+    static const size_t sHeartbeatInterval = 5 * 1000;
+
+    static LemmaRef create(const std::string& guestName, const std::string& roomName = "", const Format& format = Format());
     ~Lemma();
 
     template<typename T, typename Y>
     inline void connectMessageEventHandler(const std::string& eventName, T eventHandler, Y* eventHandlerObject) {
-        connectMessageEventHandler(eventName, std::bind(eventHandler, eventHandlerObject, std::placeholders::_2));
+        connectMessageEventHandler(eventName, std::function<void(const std::string&, const std::string&)>(std::bind(eventHandler, eventHandlerObject, std::placeholders::_2)));
     }
+    // eventValue could contain a bool, double, float, int, stringified JSON or just a string
     void connectMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const std::string&)>& eventHandler);
+    // eventValue is only valid for the duration of the call. Connect handlers before begin(), those connected later are only
+    //  registered as hears with the host once reconnected
+    void connectMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const EventValue&)>& eventHandler);
+    // decodes each event straight into a struct declared with NOAM_FIELDS, e.g. connectMessageEventHandler<Vec2f>(...)
+    template<typename T>
+    inline typename std::enable_if<FieldTable<T>::sDefined>::type connectMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const T&)>& eventHandler) {
+        connectMessageEventHandler(eventName, Fields<T>::makeHandler(eventHandler));
+    }
 
-    void sendMessage(const std::string& eventName, bool eventValue);
-    void sendMessage(const std::string& eventName, double eventValue);
-    void sendMessage(const std::string& eventName, float eventValue);
-    void sendMessage(const std::string& eventName, int eventValue);
-    void sendMessage(const std::string& eventName, const std::string& eventValue);
-    void sendMessage(const std::string& eventName, const char* eventValue);
-    void sendMessage(const std::string& eventName, const JsonTree& eventValue);
+    // handlers added for the same event all run, in the order added. An event name ending in '*' matches every heard event
+    //  starting with the rest, though only full event names are registered as hears with the host
+    size_t addMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const std::string&)>& eventHandler);
+    size_t addMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const EventValue&)>& eventHandler);
+    template<typename T>
+    inline typename std::enable_if<FieldTable<T>::sDefined, size_t>::type addMessageEventHandler(const std::string& eventName, const std::function<void(const std::string&, const T&)>& eventHandler) {
+        return addMessageEventHandler(eventName, Fields<T>::makeHandler(eventHandler));
+    }
+    void removeMessageEventHandler(size_t handlerId);
+
+    // never block, a rejected event is gone for good, e.g. over the send budget or without a host. Throttle on it rather
+    //  than queue up elsewhere
+    SendStatus sendMessage(const std::string& eventName, bool eventValue);
+    SendStatus sendMessage(const std::string& eventName, double eventValue);
+    SendStatus sendMessage(const std::string& eventName, float eventValue);
+    SendStatus sendMessage(const std::string& eventName, int eventValue);
+    SendStatus sendMessage(const std::string& eventName, const std::string& eventValue);
+    SendStatus sendMessage(const std::string& eventName, const char* eventValue);
+    SendStatus sendMessage(const std::string& eventName, const JsonTree& eventValue);
+    // forwards the value as received, without re-encoding it
+    SendStatus sendMessage(const std::string& eventName, const EventValue& eventValue);
+    // bulk values, a JSON array unless the event's policy is binary. Receivers read them back with EventValue::asFloats() etc
+    SendStatus sendMessage(const std::string& eventName, const float* values, size_t count);
+    SendStatus sendMessage(const std::string& eventName, const int32_t* values, size_t count);
+    SendStatus sendMessage(const std::string& eventName, const uint8_t* values, size_t count);
+    template<typename T>
+    inline SendStatus sendMessage(const std::string& eventName, const std::vector<T>& values) { return sendMessage(eventName, values.data(), values.size()); }
+    // structs declared with NOAM_FIELDS are encoded as a JSON object field by field, no JsonTree in between
+    template<typename T>
+    inline typename std::enable_if<FieldTable<T>::sDefined, SendStatus>::type sendMessage(const std::string& eventName, const T& eventValue) { return sendFieldsMessage(eventName, &Fields<T>::encodeValue, &eventValue); }
+
+    void setEventPolicy(const std::string& eventName, const EventPolicy& policy);
 
+    // connects to the last known host right away if there is one, while discovering in parallel
     void begin();
+    // skips discovery altogether, also when reconnecting
+    void begin(const std::string& host, uint16_t port);
+    // events go through the transport instead of a host over TCP, e.g. a LoopbackTransport within the process
+    void begin(const TransportRef& transport);
+    // when threaded, dispatch queued events on the calling thread, at most maxEvents if non-zero, returns the count dispatched
+    size_t poll(size_t maxEvents = 0);
 
     inline bool isConnected() const { return mConnected; }
+    // connected and, for hosts that acknowledge heartbeats, the last one was not missed
+    bool isHostResponsive() const;
+    // seconds from begin(), or losing the host, until connected
+    inline double getConnectDuration() const { return mConnectDuration; }
+    // shared by every lemma of a pool
+    const DiscoverySchedule::Stats& getDiscoveryStats() const;
+    inline QueueStats getQueueStats() const { QueueStats stats = mQueueStats; stats.dropped = mEventQueue ? mEventQueue->getDroppedCount() : 0; return stats; }
+
+    // events sent within the window, or the current io_service turn when 0, are written at once
+    void setFlushWindow(size_t millis);
+    // pending bytes that force a write before the window ends
+    void setFlushThreshold(size_t bytes);
+    // called as queued bytes cross the format's send watermarks, on the I/O thread when threaded. Set before begin()
+    void connectHighWatermarkEventHandler(const std::function<void()>& eventHandler);
+    void connectLowWatermarkEventHandler(const std::function<void()>& eventHandler);
+    // bytes queued or being written to the host
+    inline size_t getQueuedByteCount() const { return mWriteQueue->getSnapshot().queuedByteCount; }
+    inline bool isAboveHighWatermark() const { return mWriteQueue->isAboveHighWatermark(); }
+    HeartbeatStats getHeartbeatStats() const;
+    inline WriteQueue::Stats getWriteStats() const { return mWriteQueue->getSnapshot().stats; }
+    // events sent while not connected and not send buffered
+    inline uint64_t getDroppedEventCount() const { return mDroppedEventCount; }
+    SendBuffer::Stats getSendBufferStats() const;
+
+    // counters and histograms as of now, cheap enough to poll every frame
+    Metrics::Snapshot getMetrics() const;
+    // called at send, enqueue, write complete, read, parse and dispatch. Set before begin()
+    inline void setTraceHandler(const Metrics::TraceHandler& traceHandler) { mMetrics.setTraceHandler(traceHandler); }
 
 private:
-    Lemma(const std::string& guestName, const std::string& roomName);
+    friend class LemmaPool;
+
+    Lemma(const std::string& guestName, const std::string& roomName, const Format& format, LemmaPool* pool = nullptr);
+
+    inline boost::asio::io_service& getIoService() { return *mIoService; }
 
     void end();
+    void connect();
+    // after the last known host could not be reached, answers to the broadcasts before then were passed over
+    void restartDiscovery();
+    void loadHostCache();
+    void saveHostCache();
 
-    void setupDiscoveryClient();
-    void setupDiscoveryServer(uint16_t port);
-    void sendAvailabilityBroadcast();
+    std::string getAvailabilityMessage() const;
 
-    void setupMessagingClient(const std::string& host, uint16_t port);
+    // discovered hosts are answering right now, they take over from an attempt on the last known host still in progress
+    void setupMessagingClient(const std::string& host, uint16_t port, bool discovered = false);
     void setupMessagingServer(uint16_t port);
+    void handleMessage(const boost::string_ref& frame);
+    void receiveEvent(const boost::string_ref& eventName, const EventValue& eventValue);
+    std::vector<std::string> getHears() const;
     void sendRegistrationMessage();
     void sendHeartbeatMessage();
+    void receiveHeartbeatAck();
     template<typename T>
-    void sendEventMessage(const std::string& eventName, T eventValue);
-    void sendEventMessage(const std::string& eventName, const JsonTree& eventValue);
+    SendStatus sendEventMessage(const std::string& eventName, const T& eventValue);
+    SendStatus sendEventMessage(const std::string& eventName, const JsonTree& eventValue);
+    SendStatus sendEventMessage(const std::string& eventName, const EventValue& eventValue);
+    SendStatus sendFieldsMessage(const std::string& eventName, void (*encodeValue)(FrameEncoder&, const void*), const void* eventValue);
+    template<typename T>
+    SendStatus sendArrayMessage(const std::string& eventName, const T* values, size_t count);
     void sendJSON(const JsonTree& root);
+    FrameEncoder& getEventEncoder();
+    SendStatus commitEventFrame(const std::string& eventName, FrameEncoder& encoder);
+    void replaySendBuffer();
+    bool isBinary(const std::string& eventName) const;
+
+    Symbol internEventName(const std::string& eventName);
+    void publishHeardEvents();
+    bool hasMessageEventHandler(const boost::string_ref& eventName) const;
+    void dispatchMessageEvent(const boost::string_ref& eventName, const EventValue& eventValue);
 
-    bool mConnected;
+    std::atomic<bool> mConnected;
     std::string mGuestName;
     std::string mRoomName;
+    std::string mQuotedGuestName;
+
+    // event names are interned once, handlers and policies are indexed by symbol
+    struct MessageEventHandler {
+        size_t id;
+        std::function<void(const std::string&, const EventValue&)> handler;
+    };
+    struct PrefixMessageEventHandler {
+        size_t id;
+        std::string prefix;
+        std::function<void(const std::string&, const EventValue&)> handler;
+    };
+    SymbolTable mEventNames;
+    std::vector<std::vector<MessageEventHandler>> mMessageEventHandlers;
+    std::vector<PrefixMessageEventHandler> mPrefixMessageEventHandlers;
+    // names and prefixes with a live handler, for the I/O thread. Handlers change on the app's thread, so rather than
+    //  reading the tables above a complete copy is swapped in on every change, as LoopbackHub does with its subscribers
+    struct HeardEvents {
+        SymbolTable eventNames;
+        std::vector<std::string> prefixes;
+    };
+    std::shared_ptr<const HeardEvents> mHeardEvents;
+    std::vector<EventPolicy> mEventPolicies;
+    size_t mNextHandlerId;
+    bool mDispatching;
+    bool mHandlerRemovalPending;
+    uint64_t mDroppedEventCount;
+
+    // threading
+    Format mFormat;
+    LemmaPool* mPool;
+    boost::asio::io_service* mIoService;
+    // handlers run on the app's thread, begin() can connect right away rather than handing over to the I/O thread
+    bool mAppIoService;
+    IoServicePoolRef mIoServicePool;
+    std::unique_ptr<EventQueue> mEventQueue;
+    QueueStats mQueueStats;
+
+    // direct connection and last known host
+    std::string mDirectHost;
+    uint16_t mDirectPort;
+    std::string mCachedHost;
+    uint16_t mCachedPort;
+    bool mConnecting;
+    std::string mConnectingHost;
+    uint16_t mConnectingPort;
+    bool mConnectingDiscovered;
+    std::chrono::steady_clock::time_point mConnectStartTime;
+    std::chrono::steady_clock::time_point mBeginTime;
+    double mConnectDuration;
+    WaitTimerRef mReconnectTimer;
 
-    std::map<std::string, std::function<void(const std::string&, const std::string&)>> mMessageEventHandlerMap;
+    // discovery, the pool's when pooled
+    DiscoveryRef mDiscovery;
 
-    // discovery
-    WaitTimerRef mAvailabilityBroadcastTimer;
-    UdpClientRef mUDPClient;
-    UdpSessionRef mUDPClientSession;
-    UdpServerRef mUDPServer;
-    UdpSessionRef mUDPServerSession;
+    // alternative transport
+    TransportRef mTransport;
 
     // registration and messaging
+    Metrics mMetrics;
+    // NB - acks carry no sequence number, hosts answer heartbeats in order so each one settles the oldest outstanding
+    std::deque<std::chrono::steady_clock::time_point> mHeartbeatSendTimes;
+    // dead host detection only applies once the host has shown it acknowledges
+    bool mHeartbeatAcknowledged;
+    bool mHeartbeating;
+    HeartbeatStats mHeartbeatStats;
+    mutable std::mutex mHeartbeatMutex;
     WaitTimerRef mHeartbeatTimer;
     TcpClientRef mTCPClient;
     TcpSessionRef mTCPClientSession;
     TcpServerRef mTCPServer;
     TcpSessionRef mTCPServerSession;
+    FrameReaderRef mFrameReader;
+    Compressor mDecompressor;
+    WriteQueueRef mWriteQueue;
+    SendBufferRef mSendBuffer;
+    FrameEncoder mSendBufferEncoder;
+    MessageParser mMessageParser;
+    std::string mEventName;
 };
 
 }}
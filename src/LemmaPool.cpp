@@ -0,0 +1,188 @@
+//
+//  LemmaPool.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "LemmaPool.h"
+#include "Log.h"
+#include "cinder/app/App.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+LemmaPoolRef LemmaPool::create(const std::string& roomName, const Format& format) {
+    return LemmaPoolRef(new LemmaPool(roomName, format))->shared_from_this();
+}
+
+LemmaPool::LemmaPool(const std::string& roomName, const Format& format) : mRoomName(roomName), mFormat(format), mIoService(format.getIoService()), mAppIoService(false), mPort(0), mDiscoveredPort(0), mHeartbeating(false) {
+    if (!mIoService && mFormat.isThreaded()) {
+        mIoServicePool = IoServicePool::create(mFormat.getIoThreadCount());
+        mIoService = &mIoServicePool->getIoService();
+    }
+    if (!mIoService) {
+        mIoService = &ci::app::App::get()->io_service();
+        mAppIoService = true;
+    }
+
+    mDiscovery = Discovery::create(getIoService(), mFormat.getDiscoveryScheduleFormat());
+    mDiscovery->connectHostEventHandler([&](const std::string& host, uint16_t port) {
+        mDiscoveredHost = host;
+        mDiscoveredPort = port;
+        for (Lemma* lemma : mDiscoveringLemmas) {
+            lemma->getIoService().post([lemma, host, port]() {
+                lemma->setupMessagingClient(host, port, true);
+            });
+        }
+    });
+
+    mHeartbeatTimer = WaitTimer::create(getIoService());
+    mHeartbeatTimer->connectErrorEventHandler([](std::string message, size_t arg) {
+        NOAM_LOG_ERROR("pool heartbeat timer - " << message << " " << arg);
+    });
+    mHeartbeatTimer->connectWaitEventHandler([&]() {
+        sendHeartbeatMessages();
+    });
+}
+
+LemmaPool::~LemmaPool() {
+    // NB - stop the I/O thread before tearing down what its handlers touch
+    if (mIoServicePool) {
+        mIoServicePool->stop();
+    }
+
+    for (const LemmaRef& lemma : mLemmas) {
+        lemma->end();
+    }
+    mLemmas.clear();
+    mDiscoveringLemmas.clear();
+
+    mDiscovery = nullptr;
+    mHeartbeatTimer = nullptr;
+}
+
+#pragma mark -
+
+LemmaRef LemmaPool::createLemma(const std::string& guestName, const Lemma::Format& format) {
+    LemmaRef lemma = LemmaRef(new Lemma(guestName, mRoomName, format, this))->shared_from_this();
+    mLemmas.push_back(lemma);
+    return lemma;
+}
+
+void LemmaPool::begin() {
+    for (const LemmaRef& lemma : mLemmas) {
+        lemma->begin();
+    }
+
+    if (!mHeartbeating) {
+        mHeartbeating = true;
+        getIoService().post([&]() {
+            mHeartbeatTimer->wait(Lemma::sHeartbeatInterval, true);
+        });
+    }
+}
+
+void LemmaPool::begin(const std::string& host, uint16_t port) {
+    for (const LemmaRef& lemma : mLemmas) {
+        lemma->begin(host, port);
+    }
+
+    if (!mHeartbeating) {
+        mHeartbeating = true;
+        getIoService().post([&]() {
+            mHeartbeatTimer->wait(Lemma::sHeartbeatInterval, true);
+        });
+    }
+}
+
+size_t LemmaPool::poll(size_t maxEvents) {
+    size_t count = 0;
+    for (const LemmaRef& lemma : mLemmas) {
+        count += lemma->poll(maxEvents);
+    }
+    return count;
+}
+
+boost::asio::io_service& LemmaPool::getNextIoService() {
+    return mIoServicePool ? mIoServicePool->getNextIoService() : getIoService();
+}
+
+size_t LemmaPool::getConnectedCount() const {
+    return std::count_if(mLemmas.begin(), mLemmas.end(), [](const LemmaRef& lemma) { return lemma->isConnected(); });
+}
+
+#pragma mark -
+
+// NB - pool state is only touched on the pool's io_service and a lemma's only on its own, work is posted across
+
+void LemmaPool::discover(Lemma* lemma) {
+    getIoService().post([this, lemma]() {
+        if (std::find(mDiscoveringLemmas.begin(), mDiscoveringLemmas.end(), lemma) == mDiscoveringLemmas.end()) {
+            mDiscoveringLemmas.push_back(lemma);
+        }
+
+        // the host the others are connected to is most likely still there. Until one is, the host that answered the
+        //  broadcasts is, it may not answer again for a while
+        if (!mHost.empty()) {
+            std::string host = mHost;
+            uint16_t port = mPort;
+            lemma->getIoService().post([lemma, host, port]() {
+                lemma->setupMessagingClient(host, port);
+            });
+        } else if (!mDiscoveredHost.empty() && mDiscovery->isRunning()) {
+            std::string host = mDiscoveredHost;
+            uint16_t port = mDiscoveredPort;
+            lemma->getIoService().post([lemma, host, port]() {
+                lemma->setupMessagingClient(host, port, true);
+            });
+        }
+        // a single availability broadcast speaks for every lemma still looking, hosts answer by room
+        if (!mDiscovery->isRunning()) {
+            startDiscovery(lemma);
+        }
+    });
+}
+
+void LemmaPool::rediscover(Lemma* lemma, const std::string& host, uint16_t port) {
+    getIoService().post([this, lemma, host, port]() {
+        if (std::find(mDiscoveringLemmas.begin(), mDiscoveringLemmas.end(), lemma) == mDiscoveringLemmas.end()) {
+            mDiscoveringLemmas.push_back(lemma);
+        }
+        if (mHost == host && mPort == port) {
+            mHost.clear();
+        }
+        startDiscovery(lemma);
+    });
+}
+
+void LemmaPool::startDiscovery(Lemma* lemma) {
+    // NB - whoever answered the last cycle may have gone away since
+    mDiscoveredHost.clear();
+    mDiscovery->start(lemma->getAvailabilityMessage());
+}
+
+void LemmaPool::handleConnect(Lemma* lemma, const std::string& host, uint16_t port) {
+    getIoService().post([this, lemma, host, port]() {
+        mHost = host;
+        mPort = port;
+
+        mDiscoveringLemmas.erase(std::remove(mDiscoveringLemmas.begin(), mDiscoveringLemmas.end(), lemma), mDiscoveringLemmas.end());
+        if (mDiscoveringLemmas.empty()) {
+            mDiscovery->stop();
+        }
+    });
+}
+
+void LemmaPool::sendHeartbeatMessages() {
+    // a single timer for the lot, lemmas not connected skip it
+    for (const LemmaRef& lemma : mLemmas) {
+        Lemma* heartbeatLemma = lemma.get();
+        heartbeatLemma->getIoService().post([heartbeatLemma]() {
+            heartbeatLemma->sendHeartbeatMessage();
+        });
+    }
+}
+
+}}
@@ -0,0 +1,106 @@
+//
+//  LemmaPool.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "Lemma.h"
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class LemmaPool> LemmaPoolRef;
+
+// Many guests in one process sharing I/O threads, a single discovery cycle and heartbeat timer rather than each running
+//  their own. Noam ties a guest to the connection it registered on, so every lemma still connects to the host by itself.
+//  Each lemma is kept to one I/O thread, with several threads lemmas are spread across them. The pool owns its lemmas,
+//  they must not be used once it is gone.
+class LemmaPool : public std::enable_shared_from_this<LemmaPool> {
+public:
+    class Format {
+    public:
+        Format() : mThreaded(false), mIoThreadCount(1), mIoService(nullptr) {}
+
+        // networking runs on dedicated threads rather than the app's, received events wait in each lemma's queue until poll()
+        Format& threaded(bool threaded = true) { mThreaded = threaded; return *this; }
+        // threaded with this many threads, 0 for one per core
+        Format& ioThreads(size_t count) { mThreaded = true; mIoThreadCount = count; return *this; }
+        // networking runs on this io_service rather than the app's or the pool's own threads, on whichever threads run it
+        //  as long as they run handlers one at a time
+        Format& ioService(boost::asio::io_service& io) { mIoService = &io; return *this; }
+        // how often to broadcast availability while any lemma is without a host
+        Format& discoverySchedule(const DiscoverySchedule::Format& format) { mDiscoveryScheduleFormat = format; return *this; }
+
+        inline bool isThreaded() const { return mThreaded; }
+        inline size_t getIoThreadCount() const { return mIoThreadCount; }
+        inline boost::asio::io_service* getIoService() const { return mIoService; }
+        inline const DiscoverySchedule::Format& getDiscoveryScheduleFormat() const { return mDiscoveryScheduleFormat; }
+
+    private:
+        bool mThreaded;
+        size_t mIoThreadCount;
+        boost::asio::io_service* mIoService;
+        DiscoverySchedule::Format mDiscoveryScheduleFormat;
+    };
+
+    static LemmaPoolRef create(const std::string& roomName = "", const Format& format = Format());
+    ~LemmaPool();
+
+    // the lemma's own threading and discovery schedule are ignored in favor of the pool's. Create lemmas before begin()
+    LemmaRef createLemma(const std::string& guestName, const Lemma::Format& format = Lemma::Format());
+
+    // begins every lemma in the pool
+    void begin();
+    void begin(const std::string& host, uint16_t port);
+    // when threaded, dispatch queued events for every lemma, at most maxEvents each if non-zero, returns the count dispatched
+    size_t poll(size_t maxEvents = 0);
+
+    inline const std::string& getRoomName() const { return mRoomName; }
+    inline const std::vector<LemmaRef>& getLemmas() const { return mLemmas; }
+    size_t getConnectedCount() const;
+    inline const DiscoverySchedule::Stats& getDiscoveryStats() const { return mDiscovery->getStats(); }
+
+private:
+    friend class Lemma;
+
+    LemmaPool(const std::string& roomName, const Format& format);
+
+    inline boost::asio::io_service& getIoService() { return *mIoService; }
+    // the pool's own work runs on the first, lemmas on each in turn
+    boost::asio::io_service& getNextIoService();
+    inline bool isThreaded() const { return mFormat.isThreaded(); }
+    inline bool isAppIoService() const { return mAppIoService; }
+
+    // from lemmas looking for a host and having found one, on their I/O threads
+    void discover(Lemma* lemma);
+    // the host given to the lemma could not be reached, the cycle starts over
+    void rediscover(Lemma* lemma, const std::string& host, uint16_t port);
+    void handleConnect(Lemma* lemma, const std::string& host, uint16_t port);
+    void startDiscovery(Lemma* lemma);
+    void sendHeartbeatMessages();
+
+    std::string mRoomName;
+    Format mFormat;
+    boost::asio::io_service* mIoService;
+    bool mAppIoService;
+    IoServicePoolRef mIoServicePool;
+
+    std::vector<LemmaRef> mLemmas;
+    // lemmas waiting on discovery
+    std::vector<Lemma*> mDiscoveringLemmas;
+    DiscoveryRef mDiscovery;
+    // last host a lemma connected to, the others try it right away
+    std::string mHost;
+    uint16_t mPort;
+    // last host to answer this cycle, for lemmas that join once its answer has been handed out
+    std::string mDiscoveredHost;
+    uint16_t mDiscoveredPort;
+
+    bool mHeartbeating;
+    WaitTimerRef mHeartbeatTimer;
+};
+
+}}
@@ -0,0 +1,115 @@
+//
+//  Log.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Log.h"
+#include "cinder/app/App.h"
+#include <iostream>
+
+namespace Cinder { namespace Noam {
+
+// beyond this many unwritten messages new ones are dropped rather than piling up
+static const size_t sMaxPendingEntries = 4 * 1024;
+
+static void writeToConsole(LogLevel level, const std::string& message) {
+    // NB - there may be no app at all, e.g. a headless host
+    std::ostream& stream = cinder::app::App::get() ? cinder::app::console() : std::cerr;
+    stream << (level == LogLevel::Error ? "ERROR - " : "NOTICE - ") << message << std::endl;
+}
+
+Log& Log::get() {
+    static Log log;
+    return log;
+}
+
+Log::Log() : mLevel(NOAM_LOG_MIN_LEVEL), mAsynchronous(false), mDroppedCount(0), mSink(writeToConsole), mStopping(false) {
+    setAsynchronous(true);
+}
+
+Log::~Log() {
+    stop();
+}
+
+#pragma mark -
+
+void Log::setSink(const Sink& sink) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSink = sink ? sink : Sink(writeToConsole);
+}
+
+void Log::setAsynchronous(bool asynchronous) {
+    if (asynchronous == mAsynchronous) {
+        return;
+    }
+    if (!asynchronous) {
+        // NB - whatever is pending is still written
+        stop();
+        mAsynchronous = false;
+        return;
+    }
+
+    mStopping = false;
+    mAsynchronous = true;
+    mThread = std::thread([&]() {
+        run();
+    });
+}
+
+void Log::write(LogLevel level, std::string&& message) {
+    if (!mAsynchronous) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSink(level, message);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mEntries.size() >= sMaxPendingEntries) {
+            mDroppedCount++;
+            return;
+        }
+        Entry entry = {level, std::move(message)};
+        mEntries.push_back(std::move(entry));
+    }
+    mCondition.notify_one();
+}
+
+#pragma mark -
+
+void Log::run() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mCondition.wait(lock, [&]() {
+            return mStopping || !mEntries.empty();
+        });
+        if (mEntries.empty()) {
+            // stopping with nothing left
+            return;
+        }
+
+        Entry entry = std::move(mEntries.front());
+        mEntries.pop_front();
+        Sink sink = mSink;
+        lock.unlock();
+        sink(entry.level, entry.message);
+        lock.lock();
+    }
+}
+
+void Log::stop() {
+    if (!mThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mCondition.notify_one();
+    mThread.join();
+}
+
+}}
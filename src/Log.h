@@ -0,0 +1,95 @@
+//
+//  Log.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#define NOAM_LOG_LEVEL_NOTICE 1
+#define NOAM_LOG_LEVEL_ERROR 2
+#define NOAM_LOG_LEVEL_NONE 3
+
+// messages below this level are compiled out entirely, define it in the project's preprocessor macros to override
+#ifndef NOAM_LOG_MIN_LEVEL
+    #ifdef NDEBUG
+        #define NOAM_LOG_MIN_LEVEL NOAM_LOG_LEVEL_ERROR
+    #else
+        #define NOAM_LOG_MIN_LEVEL NOAM_LOG_LEVEL_NOTICE
+    #endif
+#endif
+
+namespace Cinder { namespace Noam {
+
+enum class LogLevel { Notice = NOAM_LOG_LEVEL_NOTICE, Error = NOAM_LOG_LEVEL_ERROR, None = NOAM_LOG_LEVEL_NONE };
+
+// Leveled logging for the block. Messages are formatted on the calling thread only when their level is enabled and
+//  written by a background thread by default, so networking never waits on console output.
+class Log {
+public:
+    typedef std::function<void(LogLevel, const std::string&)> Sink;
+
+    static Log& get();
+    ~Log();
+
+    // messages below the level are dropped at runtime, NOAM_LOG_MIN_LEVEL still applies
+    inline void setLevel(LogLevel level) { mLevel = static_cast<int>(level); }
+    inline LogLevel getLevel() const { return static_cast<LogLevel>(mLevel.load(std::memory_order_relaxed)); }
+    inline bool isEnabled(LogLevel level) const { return static_cast<int>(level) >= mLevel.load(std::memory_order_relaxed); }
+
+    // writes to console() by default, a sink runs on the writer thread when asynchronous
+    void setSink(const Sink& sink);
+    void setAsynchronous(bool asynchronous);
+    inline bool isAsynchronous() const { return mAsynchronous; }
+    // messages dropped because the writer fell behind
+    inline uint64_t getDroppedCount() const { return mDroppedCount; }
+
+    void write(LogLevel level, std::string&& message);
+
+private:
+    struct Entry {
+        LogLevel level;
+        std::string message;
+    };
+
+    Log();
+
+    void run();
+    void stop();
+
+    std::atomic<int> mLevel;
+    std::atomic<bool> mAsynchronous;
+    std::atomic<uint64_t> mDroppedCount;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Entry> mEntries;
+    Sink mSink;
+    bool mStopping;
+    std::thread mThread;
+};
+
+}}
+
+#define NOAM_LOG(level, message) \
+    do { \
+        if (static_cast<int>(level) >= NOAM_LOG_MIN_LEVEL && ::Cinder::Noam::Log::get().isEnabled(level)) { \
+            std::ostringstream noamLogStream; \
+            noamLogStream << message; \
+            ::Cinder::Noam::Log::get().write(level, noamLogStream.str()); \
+        } \
+    } while (0)
+
+#define NOAM_LOG_NOTICE(message) NOAM_LOG(::Cinder::Noam::LogLevel::Notice, message)
+#define NOAM_LOG_ERROR(message) NOAM_LOG(::Cinder::Noam::LogLevel::Error, message)
@@ -0,0 +1,141 @@
+//
+//  LoopbackTransport.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "LoopbackTransport.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+LoopbackHubRef LoopbackHub::create() {
+    return LoopbackHubRef(new LoopbackHub())->shared_from_this();
+}
+
+LoopbackHub::LoopbackHub() : mTable(std::make_shared<Table>()) {
+}
+
+LoopbackTransportRef LoopbackHub::createTransport(size_t queueCapacity) {
+    return LoopbackTransportRef(new LoopbackTransport(shared_from_this(), queueCapacity));
+}
+
+void LoopbackHub::deliver(const boost::string_ref& eventName, const EventValue& eventValue) {
+    std::shared_ptr<const Table> table = std::atomic_load(&mTable);
+    Symbol symbol = table->eventNames.find(eventName);
+    if (symbol == sInvalidSymbol) {
+        return;
+    }
+    for (const LoopbackTransportRef& transport : table->subscribers[symbol]) {
+        transport->push(eventName, eventValue);
+    }
+}
+
+void LoopbackHub::connectBridgeEventHandler(const BridgeEventHandler& eventHandler) {
+    std::atomic_store(&mBridgeEventHandler, std::shared_ptr<const BridgeEventHandler>(eventHandler ? new BridgeEventHandler(eventHandler) : nullptr));
+}
+
+#pragma mark -
+
+void LoopbackHub::subscribe(const LoopbackTransportRef& transport, const std::vector<std::string>& hears) {
+    // NB - copy on write, senders keep using the table they loaded
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::shared_ptr<Table> table = std::make_shared<Table>(*mTable);
+    for (const std::string& eventName : hears) {
+        Symbol symbol = table->eventNames.intern(eventName);
+        if (symbol >= table->subscribers.size()) {
+            table->subscribers.resize(symbol + 1);
+        }
+        std::vector<LoopbackTransportRef>& subscribers = table->subscribers[symbol];
+        if (std::find(subscribers.begin(), subscribers.end(), transport) == subscribers.end()) {
+            subscribers.push_back(transport);
+        }
+    }
+    std::atomic_store(&mTable, std::shared_ptr<const Table>(table));
+}
+
+void LoopbackHub::unsubscribe(const LoopbackTransport* transport) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::shared_ptr<Table> table = std::make_shared<Table>(*mTable);
+    for (std::vector<LoopbackTransportRef>& subscribers : table->subscribers) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [transport](const LoopbackTransportRef& subscriber) {
+            return subscriber.get() == transport;
+        }), subscribers.end());
+    }
+    std::atomic_store(&mTable, std::shared_ptr<const Table>(table));
+}
+
+void LoopbackHub::publish(const std::string& guestName, const boost::string_ref& eventName, const EventValue& eventValue) {
+    deliver(eventName, eventValue);
+
+    std::shared_ptr<const BridgeEventHandler> bridgeEventHandler = std::atomic_load(&mBridgeEventHandler);
+    if (bridgeEventHandler) {
+        (*bridgeEventHandler)(guestName, eventName, eventValue);
+    }
+}
+
+#pragma mark -
+
+LoopbackTransport::LoopbackTransport(const LoopbackHubRef& hub, size_t queueCapacity) : mHub(hub), mIoService(nullptr), mOpen(false), mQueue(queueCapacity), mDrainPosted(false) {
+}
+
+LoopbackTransport::~LoopbackTransport() {
+    close();
+}
+
+void LoopbackTransport::open(const std::string& guestName, const std::vector<std::string>& hears, boost::asio::io_service& io, const EventHandler& eventHandler) {
+    close();
+
+    mGuestName = guestName;
+    mIoService = &io;
+    mEventHandler = eventHandler;
+    mOpen = true;
+    mHub->subscribe(shared_from_this(), hears);
+}
+
+void LoopbackTransport::close() {
+    if (!mOpen) {
+        return;
+    }
+    mOpen = false;
+    mHub->unsubscribe(this);
+}
+
+void LoopbackTransport::send(const boost::string_ref& eventName, const EventValue& eventValue) {
+    if (!mOpen) {
+        return;
+    }
+    mHub->publish(mGuestName, eventName, eventValue);
+}
+
+#pragma mark -
+
+void LoopbackTransport::push(const boost::string_ref& eventName, const EventValue& eventValue) {
+    if (!mOpen || !mQueue.push(eventName, eventValue)) {
+        return;
+    }
+
+    // one drain in flight picks up everything pushed before it runs
+    if (!mDrainPosted.exchange(true)) {
+        LoopbackTransportRef transport = shared_from_this();
+        mIoService->post([transport]() {
+            transport->drain();
+        });
+    }
+}
+
+void LoopbackTransport::drain() {
+    mDrainPosted = false;
+
+    QueuedEvent* event = nullptr;
+    while ((event = mQueue.front())) {
+        if (mOpen) {
+            mEventHandler(event->getEventName(), event->getEventValue());
+        }
+        mQueue.pop();
+    }
+}
+
+}}
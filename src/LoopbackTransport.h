@@ -0,0 +1,87 @@
+//
+//  LoopbackTransport.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "Transport.h"
+#include "EventQueue.h"
+#include "SymbolTable.h"
+#include <mutex>
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class LoopbackHub> LoopbackHubRef;
+typedef std::shared_ptr<class LoopbackTransport> LoopbackTransportRef;
+
+// Routes events between lemmas in the same process without sockets or serialization. Each transport receives into its
+//  own lock-free queue, drained on the io_service it was opened with. Senders look subscribers up in an immutable table
+//  that is swapped on open and close, so sending never takes a lock.
+class LoopbackHub : public std::enable_shared_from_this<LoopbackHub> {
+public:
+    // a co-located host forwards events sent through the hub to its TCP guests, on the sender's thread
+    typedef std::function<void(const boost::string_ref&, const boost::string_ref&, const EventValue&)> BridgeEventHandler;
+
+    static LoopbackHubRef create();
+
+    LoopbackTransportRef createTransport(size_t queueCapacity = 1024);
+
+    // hands the event to every transport hearing it, not to the bridge
+    void deliver(const boost::string_ref& eventName, const EventValue& eventValue);
+
+    void connectBridgeEventHandler(const BridgeEventHandler& eventHandler);
+
+private:
+    friend class LoopbackTransport;
+
+    struct Table {
+        SymbolTable eventNames;
+        std::vector<std::vector<LoopbackTransportRef>> subscribers;
+    };
+
+    LoopbackHub();
+
+    void subscribe(const LoopbackTransportRef& transport, const std::vector<std::string>& hears);
+    void unsubscribe(const LoopbackTransport* transport);
+    void publish(const std::string& guestName, const boost::string_ref& eventName, const EventValue& eventValue);
+
+    std::mutex mMutex;
+    std::shared_ptr<const Table> mTable;
+    std::shared_ptr<const BridgeEventHandler> mBridgeEventHandler;
+};
+
+class LoopbackTransport : public Transport, public std::enable_shared_from_this<LoopbackTransport> {
+public:
+    ~LoopbackTransport();
+
+    void open(const std::string& guestName, const std::vector<std::string>& hears, boost::asio::io_service& io, const EventHandler& eventHandler) override;
+    void close() override;
+    inline bool isOpen() const override { return mOpen; }
+    void send(const boost::string_ref& eventName, const EventValue& eventValue) override;
+
+    inline uint64_t getDroppedCount() const { return mQueue.getDroppedCount(); }
+
+private:
+    friend class LoopbackHub;
+
+    LoopbackTransport(const LoopbackHubRef& hub, size_t queueCapacity);
+
+    // any thread
+    void push(const boost::string_ref& eventName, const EventValue& eventValue);
+    // io_service thread
+    void drain();
+
+    LoopbackHubRef mHub;
+    std::string mGuestName;
+    boost::asio::io_service* mIoService;
+    EventHandler mEventHandler;
+    std::atomic<bool> mOpen;
+    EventQueue mQueue;
+    std::atomic<bool> mDrainPosted;
+};
+
+}}
@@ -0,0 +1,107 @@
+//
+//  MessageParser.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "MessageParser.h"
+
+namespace Cinder { namespace Noam {
+
+static const boost::string_ref sEventMessageHeader = "event";
+static const boost::string_ref sRegistrationMessageHeader = "register";
+static const boost::string_ref sHeartbeatHeader = "heartbeat";
+
+MessageParser::MessageParser() : mIsEvent(false), mIsRegistration(false) {
+}
+
+bool MessageParser::parse(const boost::string_ref& frame) {
+    mReader.reset(frame);
+    mHeader.clear();
+    mIsEvent = false;
+    mGuestName.clear();
+    mEventName.clear();
+    mEventValue = EventValue();
+    mIsRegistration = false;
+
+    if (!mReader.expect('[') || !mReader.readString(mHeader)) {
+        return false;
+    }
+    if (mHeader == sRegistrationMessageHeader) {
+        mIsRegistration = parseRegistration();
+        return mIsRegistration;
+    } else if (mHeader == sHeartbeatHeader) {
+        return mReader.expect(',') && mReader.readString(mGuestName);
+    } else if (mHeader != sEventMessageHeader) {
+        // NB - the rest of other messages is not needed by a lemma
+        return true;
+    }
+
+    mIsEvent = mReader.expect(',') && mReader.readString(mGuestName) && mReader.expect(',') && mReader.readString(mEventName) && mReader.expect(',') && mReader.readValue(mEventValue) && mReader.expect(']');
+    return mIsEvent;
+}
+
+#pragma mark -
+
+bool MessageParser::parseRegistration() {
+    mRegistration.hears.clear();
+    mRegistration.speaks.clear();
+    mRegistration.heartbeatInterval = 0;
+    mRegistration.heartbeatAck = false;
+    mRegistration.compression.clear();
+
+    EventValue port;
+    if (!(mReader.expect(',') && mReader.readString(mRegistration.guestName) && mReader.expect(',') && mReader.readValue(port) && mReader.expect(',') && readStringArray(mRegistration.hears) && mReader.expect(',') && readStringArray(mRegistration.speaks) && mReader.expect(',') && mReader.readString(mRegistration.dialect) && mReader.expect(',') && mReader.readString(mRegistration.version))) {
+        return false;
+    }
+    mRegistration.port = static_cast<uint16_t>(port.asInt());
+    mGuestName = mRegistration.guestName;
+
+    // options are optional
+    if (mReader.consume(',')) {
+        if (!mReader.expect('{')) {
+            return false;
+        }
+        if (!mReader.consume('}')) {
+            do {
+                boost::string_ref key;
+                EventValue value;
+                if (!mReader.readString(key) || !mReader.expect(':') || !mReader.readValue(value)) {
+                    return false;
+                }
+                if (key == "heartbeat") {
+                    mRegistration.heartbeatInterval = value.asInt();
+                } else if (key == "heartbeat_ack") {
+                    mRegistration.heartbeatAck = value.asBool();
+                } else if (key == "compression") {
+                    mRegistration.compression = value.asString();
+                }
+            } while (mReader.consume(','));
+            if (!mReader.expect('}')) {
+                return false;
+            }
+        }
+    }
+    return mReader.expect(']');
+}
+
+bool MessageParser::readStringArray(std::vector<boost::string_ref>& strings) {
+    if (!mReader.expect('[')) {
+        return false;
+    }
+    if (mReader.consume(']')) {
+        return true;
+    }
+    do {
+        boost::string_ref string;
+        if (!mReader.readString(string)) {
+            return false;
+        }
+        strings.push_back(string);
+    } while (mReader.consume(','));
+    return mReader.expect(']');
+}
+
+}}
@@ -0,0 +1,65 @@
+//
+//  MessageParser.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "JsonReader.h"
+#include <vector>
+
+namespace Cinder { namespace Noam {
+
+// Pulls the header, and for events the guest name, event name and value, out of a frame in a single pass. Registrations
+//  and heartbeats, which only a host receives, are parsed as well. Results are views into the frame or the parser and
+//  valid until the next parse().
+class MessageParser {
+public:
+    struct Registration {
+        Registration() : port(0), heartbeatInterval(0), heartbeatAck(false) {}
+
+        boost::string_ref guestName;
+        uint16_t port;
+        std::vector<boost::string_ref> hears;
+        std::vector<boost::string_ref> speaks;
+        boost::string_ref dialect;
+        boost::string_ref version;
+        // seconds, 0 when the guest does not send heartbeats
+        int64_t heartbeatInterval;
+        bool heartbeatAck;
+        // frame compression the guest can receive, empty when none
+        boost::string_ref compression;
+    };
+
+    MessageParser();
+
+    bool parse(const boost::string_ref& frame);
+
+    inline boost::string_ref getHeader() const { return mHeader; }
+    inline bool isEvent() const { return mIsEvent; }
+    inline boost::string_ref getGuestName() const { return mGuestName; }
+    inline boost::string_ref getEventName() const { return mEventName; }
+    inline const EventValue& getEventValue() const { return mEventValue; }
+    inline bool isRegistration() const { return mIsRegistration; }
+    inline const Registration& getRegistration() const { return mRegistration; }
+
+    inline const std::string& getError() const { return mReader.getError(); }
+
+private:
+    bool parseRegistration();
+    bool readStringArray(std::vector<boost::string_ref>& strings);
+
+    JsonReader mReader;
+    boost::string_ref mHeader;
+    bool mIsEvent;
+    boost::string_ref mGuestName;
+    boost::string_ref mEventName;
+    EventValue mEventValue;
+    bool mIsRegistration;
+    Registration mRegistration;
+};
+
+}}
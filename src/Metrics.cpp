@@ -0,0 +1,100 @@
+//
+//  Metrics.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Metrics.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+const size_t Histogram::sBucketCount;
+const size_t Metrics::sMaxEventHistograms;
+
+Histogram::Histogram() : mCount(0), mSum(0), mMax(0) {
+    for (std::atomic<uint64_t>& bucket : mBuckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::record(uint64_t micros) {
+    // bucket n holds [2^n - 1, 2^(n+1) - 1)
+    size_t bucket = 0;
+    for (uint64_t value = micros + 1; value > 1 && bucket < sBucketCount - 1; value >>= 1) {
+        bucket++;
+    }
+    mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t max = mMax.load(std::memory_order_relaxed);
+    while (micros > max && !mMax.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+    }
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const {
+    Snapshot snapshot;
+    snapshot.count = mCount.load(std::memory_order_relaxed);
+    snapshot.sum = mSum.load(std::memory_order_relaxed);
+    snapshot.max = mMax.load(std::memory_order_relaxed);
+    for (size_t idx = 0; idx < sBucketCount; idx++) {
+        snapshot.buckets[idx] = mBuckets[idx].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+uint64_t Histogram::Snapshot::getPercentile(double p) const {
+    uint64_t total = 0;
+    for (uint64_t bucket : buckets) {
+        total += bucket;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(std::max(0.0, std::min(p, 1.0)) * (total - 1));
+    uint64_t seen = 0;
+    for (size_t idx = 0; idx < sBucketCount; idx++) {
+        seen += buckets[idx];
+        if (seen > rank) {
+            return std::min((static_cast<uint64_t>(2) << idx) - 2, max);
+        }
+    }
+    return max;
+}
+
+#pragma mark -
+
+Metrics::Metrics() : mDispatch(new Histogram[sMaxEventHistograms]) {
+    for (std::atomic<uint64_t>& counter : mCounters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+Metrics::Snapshot Metrics::getSnapshot(const SymbolTable& eventNames) const {
+    Snapshot snapshot;
+    for (size_t idx = 0; idx < mCounters.size(); idx++) {
+        snapshot.counters[idx] = mCounters[idx].load(std::memory_order_relaxed);
+    }
+    snapshot.heartbeatRoundTrip = mHeartbeat.getSnapshot();
+
+    size_t count = std::min(eventNames.size(), sMaxEventHistograms);
+    for (Symbol symbol = 0; symbol < count; symbol++) {
+        Histogram::Snapshot dispatch = mDispatch[symbol].getSnapshot();
+        if (dispatch.count) {
+            EventSnapshot event = {eventNames.getName(symbol), dispatch};
+            snapshot.events.push_back(event);
+        }
+    }
+    Histogram::Snapshot overflow = mDispatchOverflow.getSnapshot();
+    if (overflow.count) {
+        EventSnapshot event = {"*", overflow};
+        snapshot.events.push_back(event);
+    }
+    return snapshot;
+}
+
+}}
@@ -0,0 +1,107 @@
+//
+//  Metrics.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "SymbolTable.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace Cinder { namespace Noam {
+
+// Durations in microseconds, bucketed by powers of two. Recording is a handful of relaxed atomic adds.
+class Histogram {
+public:
+    static const size_t sBucketCount = 32;
+
+    struct Snapshot {
+        Snapshot() : count(0), sum(0), max(0) { buckets.fill(0); }
+        inline double getAverage() const { return count ? static_cast<double>(sum) / count : 0.0; }
+        // upper bound of the bucket holding the percentile, p in [0, 1]
+        uint64_t getPercentile(double p) const;
+
+        uint64_t count;
+        uint64_t sum;
+        uint64_t max;
+        std::array<uint64_t, sBucketCount> buckets;
+    };
+
+    Histogram();
+
+    void record(uint64_t micros);
+    Snapshot getSnapshot() const;
+
+private:
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSum;
+    std::atomic<uint64_t> mMax;
+    std::array<std::atomic<uint64_t>, sBucketCount> mBuckets;
+};
+
+// Counters, histograms and trace hooks for a lemma. Recording never locks or allocates, so it stays on in production;
+//  snapshots are taken on demand and may be a moment apart between fields.
+class Metrics {
+public:
+    enum class Counter { FramesIn, BytesIn, FramesOut, BytesOut, Writes, ParseErrors, DroppedFrames, Reconnects, Count };
+    enum class Trace { Send, Enqueue, WriteComplete, Read, Parse, Dispatch };
+
+    // eventName is empty where there is none. The size is in bytes, but for Dispatch the microseconds spent in handlers,
+    //  and 0 where it does not apply
+    typedef std::function<void(Trace, const boost::string_ref&, size_t)> TraceHandler;
+
+    // dispatch time is kept per event name, names interned beyond this share one histogram
+    static const size_t sMaxEventHistograms = 128;
+
+    struct EventSnapshot {
+        std::string eventName;
+        Histogram::Snapshot dispatch;
+    };
+
+    struct Snapshot {
+        Snapshot() : writeQueueDepth(0), timeToDiscover(0.0) { counters.fill(0); }
+        inline uint64_t get(Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+
+        std::array<uint64_t, static_cast<size_t>(Counter::Count)> counters;
+        size_t writeQueueDepth;
+        // seconds, most recent
+        double timeToDiscover;
+        Histogram::Snapshot heartbeatRoundTrip;
+        // only names that were dispatched
+        std::vector<EventSnapshot> events;
+    };
+
+    Metrics();
+
+    inline void increment(Counter counter, uint64_t amount = 1) { mCounters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed); }
+    inline uint64_t get(Counter counter) const { return mCounters[static_cast<size_t>(counter)].load(std::memory_order_relaxed); }
+
+    inline Histogram& getDispatchHistogram(Symbol symbol) { return symbol < sMaxEventHistograms ? mDispatch[symbol] : mDispatchOverflow; }
+    inline Histogram& getHeartbeatHistogram() { return mHeartbeat; }
+
+    // set before begin(), handlers run on the thread doing the work and must be quick
+    inline void setTraceHandler(const TraceHandler& traceHandler) { mTraceHandler = traceHandler; }
+    inline void trace(Trace trace, const boost::string_ref& eventName = boost::string_ref(), size_t bytes = 0) const {
+        if (mTraceHandler) {
+            mTraceHandler(trace, eventName, bytes);
+        }
+    }
+
+    // counters and histograms, the caller fills in what the metrics do not own
+    Snapshot getSnapshot(const SymbolTable& eventNames) const;
+
+private:
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::Count)> mCounters;
+    std::unique_ptr<Histogram[]> mDispatch;
+    Histogram mDispatchOverflow;
+    Histogram mHeartbeat;
+    TraceHandler mTraceHandler;
+};
+
+}}
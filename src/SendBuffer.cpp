@@ -0,0 +1,322 @@
+//
+//  SendBuffer.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "SendBuffer.h"
+#include "Log.h"
+#include "SymbolTable.h"
+#include <cstring>
+#include <fstream>
+
+namespace Cinder { namespace Noam {
+
+static const char sMagic[4] = {'N', 'S', 'B', '2'};
+static const size_t sAlignment = 8;
+static const size_t sNoOffset = static_cast<size_t>(-1);
+
+// NB - laid out the same in memory and on disk, the file is only ever read back by the same build
+struct SendBuffer::Header {
+    char magic[4];
+    uint32_t reserved;
+    uint64_t capacity;
+    // bytes of records, live or not
+    uint64_t used;
+};
+
+// followed by the event name, then the data
+struct SendBuffer::Record {
+    uint32_t size;
+    uint32_t key;
+    int32_t priority;
+    uint32_t live;
+    // milliseconds since the epoch, 0 never. Wall clock so it holds across runs
+    int64_t expiry;
+    uint32_t nameSize;
+    uint32_t reserved;
+};
+
+SendBufferRef SendBuffer::create(const Format& format) {
+    return SendBufferRef(new SendBuffer(format));
+}
+
+SendBuffer::SendBuffer(const Format& format) : mFormat(format), mCapacity(format.getCapacity()), mData(nullptr), mRemovedSize(0) {
+    size_t size = sizeof(Header) + mCapacity;
+    if (!mFormat.getPath().empty() && map(mFormat.getPath(), size)) {
+        mData = static_cast<char*>(mRegion->get_address());
+    } else {
+        mMemory.resize(size);
+        mData = mMemory.data();
+    }
+    restore();
+}
+
+SendBuffer::~SendBuffer() {
+    if (mRegion) {
+        mRegion->flush();
+    }
+    mRegion = nullptr;
+    mFile = nullptr;
+}
+
+#pragma mark -
+
+bool SendBuffer::push(const boost::string_ref& eventName, bool conflated, int priority, size_t timeToLive, const char* data, size_t size) {
+    size_t recordSize = getRecordSize(eventName.size() + size);
+    if (recordSize > mCapacity) {
+        mStats.dropped++;
+        return false;
+    }
+
+    int64_t time = now();
+    uint32_t key = SymbolTable::hash(eventName);
+    Header* header = getHeader();
+    if (header->used + recordSize > mCapacity) {
+        purgeExpired(time);
+    }
+
+    // NB - the entry a conflated one replaces is only removed once the new one is sure to fit, until then its space
+    //  counts as free and eviction passes it over. Dropped instead, the newer value would take the older one with it
+    size_t replacedOffset = sNoOffset;
+    size_t replacedSize = 0;
+    size_t replaced = conflated ? find(key, eventName) : mEntries.size();
+    if (replaced < mEntries.size()) {
+        replacedOffset = mEntries[replaced].offset;
+        replacedSize = getRecordSize(getRecord(replacedOffset));
+    }
+    while (getSize() - replacedSize + recordSize > mCapacity) {
+        if (!evict(key, eventName, priority, replacedOffset)) {
+            mStats.dropped++;
+            return false;
+        }
+    }
+    if (replacedOffset != sNoOffset) {
+        // NB - eviction passed over it, so it is still the first entry for the event
+        remove(find(key, eventName));
+        mStats.conflated++;
+    }
+    if (header->used + recordSize > mCapacity) {
+        compact();
+    }
+
+    size_t offset = header->used;
+    Record* record = getRecord(offset);
+    record->size = static_cast<uint32_t>(size);
+    record->key = key;
+    record->priority = priority;
+    record->live = 1;
+    record->expiry = timeToLive ? time + static_cast<int64_t>(timeToLive) : 0;
+    record->nameSize = static_cast<uint32_t>(eventName.size());
+    record->reserved = 0;
+    std::memcpy(record + 1, eventName.data(), eventName.size());
+    std::memcpy(reinterpret_cast<char*>(record + 1) + eventName.size(), data, size);
+    // NB - only counts once written, a file cut short mid-push reads back without it
+    header->used += recordSize;
+
+    Entry entry = {offset, key, priority};
+    mEntries.push_back(entry);
+    mStats.buffered++;
+    return true;
+}
+
+void SendBuffer::drain(const std::function<void(const char*, size_t)>& handler) {
+    int64_t time = now();
+    for (const Entry& entry : mEntries) {
+        const Record* record = getRecord(entry.offset);
+        if (record->expiry && record->expiry <= time) {
+            mStats.expired++;
+            continue;
+        }
+        handler(reinterpret_cast<const char*>(record + 1) + record->nameSize, record->size);
+        mStats.replayed++;
+    }
+
+    mEntries.clear();
+    mRemovedSize = 0;
+    getHeader()->used = 0;
+}
+
+size_t SendBuffer::getSize() const {
+    return static_cast<size_t>(getHeader()->used) - mRemovedSize;
+}
+
+#pragma mark -
+
+bool SendBuffer::map(const fs::path& path, size_t size) {
+    // NB - a mapping cannot grow the file, it is sized up front. Zeroed, it reads back as empty
+    boost::system::error_code err;
+    if (!fs::exists(path, err) || fs::file_size(path, err) != size) {
+        if (fs::exists(path, err)) {
+            NOAM_LOG_NOTICE("send buffer " << path << " has a different capacity, starting out empty");
+        }
+        std::ofstream stream(path.string().c_str(), std::ios::binary | std::ios::trunc);
+        stream.close();
+        fs::resize_file(path, size, err);
+        if (!stream || err) {
+            NOAM_LOG_ERROR("failed to create send buffer " << path << " - " << err.message());
+            return false;
+        }
+    }
+
+    try {
+        mFile.reset(new boost::interprocess::file_mapping(path.string().c_str(), boost::interprocess::read_write));
+        mRegion.reset(new boost::interprocess::mapped_region(*mFile, boost::interprocess::read_write));
+    } catch (const boost::interprocess::interprocess_exception& exception) {
+        NOAM_LOG_ERROR("failed to map send buffer " << path << " - " << exception.what());
+        mRegion = nullptr;
+        mFile = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void SendBuffer::restore() {
+    Header* header = getHeader();
+    if (std::memcmp(header->magic, sMagic, sizeof(sMagic)) != 0 || header->capacity != mCapacity || header->used > mCapacity) {
+        std::memcpy(header->magic, sMagic, sizeof(sMagic));
+        header->reserved = 0;
+        header->capacity = mCapacity;
+        header->used = 0;
+        return;
+    }
+
+    // anything past the first record that does not add up was cut short and is dropped
+    size_t offset = 0;
+    while (offset < header->used) {
+        const Record* record = getRecord(offset);
+        size_t remaining = static_cast<size_t>(header->used) - offset;
+        if (remaining < sizeof(Record) || getRecordSize(record) > remaining) {
+            header->used = offset;
+            break;
+        }
+
+        size_t recordSize = getRecordSize(record);
+        if (record->live) {
+            Entry entry = {offset, record->key, record->priority};
+            mEntries.push_back(entry);
+            mStats.restored++;
+        } else {
+            mRemovedSize += recordSize;
+        }
+        offset += recordSize;
+    }
+}
+
+void SendBuffer::remove(size_t idx) {
+    Record* record = getRecord(mEntries[idx].offset);
+    record->live = 0;
+    mRemovedSize += getRecordSize(record);
+    mEntries.erase(mEntries.begin() + idx);
+}
+
+bool SendBuffer::isEvent(const Entry& entry, uint32_t key, const boost::string_ref& eventName) const {
+    if (entry.key != key) {
+        return false;
+    }
+    const Record* record = getRecord(entry.offset);
+    return boost::string_ref(reinterpret_cast<const char*>(record + 1), record->nameSize) == eventName;
+}
+
+size_t SendBuffer::find(uint32_t key, const boost::string_ref& eventName) const {
+    for (size_t idx = 0; idx < mEntries.size(); idx++) {
+        if (isEvent(mEntries[idx], key, eventName)) {
+            return idx;
+        }
+    }
+    return mEntries.size();
+}
+
+bool SendBuffer::evict(uint32_t key, const boost::string_ref& eventName, int priority, size_t keptOffset) {
+    // lower priority goes first regardless of the policy, the lowest and oldest of it
+    size_t victim = mEntries.size();
+    for (size_t idx = 0; idx < mEntries.size(); idx++) {
+        if (mEntries[idx].offset == keptOffset) {
+            continue;
+        }
+        if (mEntries[idx].priority < priority && (victim == mEntries.size() || mEntries[idx].priority < mEntries[victim].priority)) {
+            victim = idx;
+        }
+    }
+
+    Overflow overflow = mFormat.getOverflow();
+    if (victim == mEntries.size() && overflow == Overflow::Conflate) {
+        for (size_t idx = 0; idx < mEntries.size(); idx++) {
+            if (mEntries[idx].offset != keptOffset && mEntries[idx].priority == priority && isEvent(mEntries[idx], key, eventName)) {
+                victim = idx;
+                break;
+            }
+        }
+    }
+    if (victim == mEntries.size() && overflow != Overflow::DropNewest) {
+        for (size_t idx = 0; idx < mEntries.size(); idx++) {
+            if (mEntries[idx].offset != keptOffset && mEntries[idx].priority == priority) {
+                victim = idx;
+                break;
+            }
+        }
+    }
+    if (victim == mEntries.size()) {
+        return false;
+    }
+
+    remove(victim);
+    mStats.dropped++;
+    return true;
+}
+
+void SendBuffer::purgeExpired(int64_t time) {
+    for (size_t idx = 0; idx < mEntries.size();) {
+        const Record* record = getRecord(mEntries[idx].offset);
+        if (record->expiry && record->expiry <= time) {
+            remove(idx);
+            mStats.expired++;
+        } else {
+            idx++;
+        }
+    }
+}
+
+void SendBuffer::compact() {
+    if (!mRemovedSize) {
+        return;
+    }
+
+    size_t offset = 0;
+    for (Entry& entry : mEntries) {
+        size_t recordSize = getRecordSize(getRecord(entry.offset));
+        if (entry.offset != offset) {
+            std::memmove(getRecord(offset), getRecord(entry.offset), recordSize);
+            entry.offset = offset;
+        }
+        offset += recordSize;
+    }
+    getHeader()->used = offset;
+    mRemovedSize = 0;
+}
+
+#pragma mark -
+
+SendBuffer::Header* SendBuffer::getHeader() const {
+    return reinterpret_cast<Header*>(mData);
+}
+
+SendBuffer::Record* SendBuffer::getRecord(size_t offset) const {
+    return reinterpret_cast<Record*>(mData + sizeof(Header) + offset);
+}
+
+size_t SendBuffer::getRecordSize(size_t dataSize) {
+    return sizeof(Record) + (dataSize + sAlignment - 1) / sAlignment * sAlignment;
+}
+
+size_t SendBuffer::getRecordSize(const Record* record) {
+    return getRecordSize(static_cast<size_t>(record->nameSize) + record->size);
+}
+
+int64_t SendBuffer::now() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}}
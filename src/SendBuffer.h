@@ -0,0 +1,131 @@
+//
+//  SendBuffer.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "boost/utility/string_ref.hpp"
+#include "cinder/Filesystem.h"
+
+namespace Cinder { namespace Noam {
+
+using namespace ci;
+
+typedef std::shared_ptr<class SendBuffer> SendBufferRef;
+
+// Bounded store for events sent while there is no host, replayed in order once registered again. Entries are laid out
+//  back to back in a single region, either plain memory or a memory mapped file so whatever was buffered when the process
+//  went away is still there on the next run. Removed entries leave a hole until the region is compacted. Not thread safe.
+class SendBuffer {
+public:
+    // what gives once full. Entries of lower priority than a new one are always evicted first, oldest first
+    enum class Overflow {
+        // the oldest entry of the same or lower priority
+        DropOldest,
+        // the new entry
+        DropNewest,
+        // the oldest entry for the same event, then as DropOldest
+        Conflate
+    };
+
+    class Format {
+    public:
+        Format() : mCapacity(256 * 1024), mOverflow(Overflow::DropOldest) {}
+
+        // bytes of encoded events, bookkeeping aside
+        Format& capacity(size_t bytes) { mCapacity = bytes; return *this; }
+        Format& overflow(Overflow overflow) { mOverflow = overflow; return *this; }
+        // backed by this file rather than memory alone, a file left with a different capacity starts out empty
+        Format& path(const fs::path& path) { mPath = path; return *this; }
+
+        inline size_t getCapacity() const { return mCapacity; }
+        inline Overflow getOverflow() const { return mOverflow; }
+        inline const fs::path& getPath() const { return mPath; }
+
+    private:
+        size_t mCapacity;
+        Overflow mOverflow;
+        fs::path mPath;
+    };
+
+    struct Stats {
+        Stats() : buffered(0), replayed(0), restored(0), expired(0), conflated(0), dropped(0) {}
+
+        uint64_t buffered;
+        uint64_t replayed;
+        // found in the file when opened
+        uint64_t restored;
+        uint64_t expired;
+        uint64_t conflated;
+        // to overflow
+        uint64_t dropped;
+    };
+
+    static SendBufferRef create(const Format& format = Format());
+    ~SendBuffer();
+
+    // a conflated entry replaces a buffered one for the same event. timeToLive in milliseconds, 0 never expires. false if
+    //  dropped
+    bool push(const boost::string_ref& eventName, bool conflated, int priority, size_t timeToLive, const char* data, size_t size);
+    // hands over every unexpired entry in the order pushed, then empties the buffer
+    void drain(const std::function<void(const char*, size_t)>& handler);
+
+    inline bool isEmpty() const { return mEntries.empty(); }
+    inline bool isPersistent() const { return static_cast<bool>(mRegion); }
+    inline size_t getCount() const { return mEntries.size(); }
+    size_t getSize() const;
+    inline size_t getCapacity() const { return mCapacity; }
+    inline const Stats& getStats() const { return mStats; }
+
+private:
+    struct Header;
+    struct Record;
+    struct Entry {
+        size_t offset;
+        // of the event name, names are compared only when it matches
+        uint32_t key;
+        int priority;
+    };
+
+    SendBuffer(const Format& format);
+
+    bool map(const fs::path& path, size_t size);
+    void restore();
+    void remove(size_t idx);
+    bool isEvent(const Entry& entry, uint32_t key, const boost::string_ref& eventName) const;
+    // index of the first entry for the event, the count if none
+    size_t find(uint32_t key, const boost::string_ref& eventName) const;
+    // removes one entry to make room, never the one at keptOffset
+    bool evict(uint32_t key, const boost::string_ref& eventName, int priority, size_t keptOffset);
+    void purgeExpired(int64_t time);
+    void compact();
+
+    Header* getHeader() const;
+    Record* getRecord(size_t offset) const;
+    static size_t getRecordSize(size_t dataSize);
+    static size_t getRecordSize(const Record* record);
+    static int64_t now();
+
+    Format mFormat;
+    size_t mCapacity;
+    std::vector<char> mMemory;
+    std::unique_ptr<boost::interprocess::file_mapping> mFile;
+    std::unique_ptr<boost::interprocess::mapped_region> mRegion;
+    char* mData;
+    std::vector<Entry> mEntries;
+    size_t mRemovedSize;
+    Stats mStats;
+};
+
+}}
@@ -0,0 +1,100 @@
+//
+//  SymbolTable.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "SymbolTable.h"
+
+namespace Cinder { namespace Noam {
+
+SymbolTable::Index::Index(size_t bucketCount) : mask(bucketCount - 1), buckets(new std::atomic<uint32_t>[bucketCount]), entries(new const Entry*[bucketCount / 2]) {
+    for (size_t idx = 0; idx < bucketCount; idx++) {
+        buckets[idx].store(0, std::memory_order_relaxed);
+    }
+}
+
+#pragma mark -
+
+SymbolTable::SymbolTable() : mIndex(nullptr), mSize(0) {
+    mIndices.emplace_back(new Index(16));
+    mIndex.store(mIndices.back().get(), std::memory_order_release);
+}
+
+SymbolTable::SymbolTable(const SymbolTable& other) : SymbolTable() {
+    size_t size = other.size();
+    for (Symbol symbol = 0; symbol < size; symbol++) {
+        intern(other.getName(symbol));
+    }
+}
+
+Symbol SymbolTable::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Index* index = mIndex.load(std::memory_order_relaxed);
+    uint32_t nameHash = hash(name);
+    Symbol symbol = find(*index, name, nameHash);
+    if (symbol != sInvalidSymbol) {
+        return symbol;
+    }
+
+    symbol = static_cast<Symbol>(mEntries.size());
+    Entry* entry = new Entry{name, nameHash};
+    mEntries.emplace_back(entry);
+
+    // NB - stay at most half full so probe sequences remain short
+    if ((symbol + 1) * 2 > index->mask + 1) {
+        Index* larger = new Index((index->mask + 1) * 2);
+        mIndices.emplace_back(larger);
+        for (Symbol existing = 0; existing < symbol; existing++) {
+            larger->entries[existing] = index->entries[existing];
+            insert(*larger, existing, index->entries[existing]->hash);
+        }
+        index = larger;
+    }
+    index->entries[symbol] = entry;
+    insert(*index, symbol, nameHash);
+
+    mIndex.store(index, std::memory_order_release);
+    mSize.store(mEntries.size(), std::memory_order_release);
+    return symbol;
+}
+
+Symbol SymbolTable::find(const boost::string_ref& name) const {
+    return find(*mIndex.load(std::memory_order_acquire), name, hash(name));
+}
+
+uint32_t SymbolTable::hash(const boost::string_ref& name) {
+    // FNV-1a
+    uint32_t result = 2166136261u;
+    for (char c : name) {
+        result ^= static_cast<unsigned char>(c);
+        result *= 16777619u;
+    }
+    return result;
+}
+
+#pragma mark -
+
+Symbol SymbolTable::find(const Index& index, const boost::string_ref& name, uint32_t nameHash) const {
+    uint32_t bucket = 0;
+    for (size_t idx = nameHash & index.mask; (bucket = index.buckets[idx].load(std::memory_order_acquire)) != 0; idx = (idx + 1) & index.mask) {
+        const Entry* entry = index.entries[bucket - 1];
+        if (entry->hash == nameHash && name == entry->name) {
+            return bucket - 1;
+        }
+    }
+    return sInvalidSymbol;
+}
+
+void SymbolTable::insert(Index& index, Symbol symbol, uint32_t nameHash) {
+    size_t idx = nameHash & index.mask;
+    while (index.buckets[idx].load(std::memory_order_relaxed) != 0) {
+        idx = (idx + 1) & index.mask;
+    }
+    // NB - the entry is in place before the bucket pointing at it is published
+    index.buckets[idx].store(symbol + 1, std::memory_order_release);
+}
+
+}}
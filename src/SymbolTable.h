@@ -0,0 +1,72 @@
+//
+//  SymbolTable.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "boost/utility/string_ref.hpp"
+
+namespace Cinder { namespace Noam {
+
+typedef uint32_t Symbol;
+static const Symbol sInvalidSymbol = UINT32_MAX;
+
+// Interns names into dense integer symbols. Lookups hash the name once and probe an open addressed table, so a name
+//  straight out of a received frame resolves without allocating. Symbols are never removed.
+//  Lookups may run on any thread while another interns, e.g. the I/O thread resolving a received name as the app adds a
+//  handler. The table only ever grows: a new name is filled in before its bucket is published, and when the table is
+//  outgrown a larger one is built alongside and swapped in. Lookups never lock, interning is serialized.
+class SymbolTable {
+public:
+    SymbolTable();
+    SymbolTable(const SymbolTable& other);
+    SymbolTable& operator=(const SymbolTable& other) = delete;
+
+    Symbol intern(const std::string& name);
+    // sInvalidSymbol when the name was never interned
+    Symbol find(const boost::string_ref& name) const;
+
+    // any symbol below size(), on any thread
+    inline const std::string& getName(Symbol symbol) const { return mIndex.load(std::memory_order_acquire)->entries[symbol]->name; }
+    inline size_t size() const { return mSize.load(std::memory_order_acquire); }
+
+    static uint32_t hash(const boost::string_ref& name);
+
+private:
+    struct Entry {
+        std::string name;
+        uint32_t hash;
+    };
+
+    // buckets and entries are allocated up front, at most half as many entries as buckets
+    struct Index {
+        explicit Index(size_t bucketCount);
+
+        size_t mask;
+        // symbol + 1, 0 marks an empty bucket
+        std::unique_ptr<std::atomic<uint32_t>[]> buckets;
+        std::unique_ptr<const Entry*[]> entries;
+    };
+
+    Symbol find(const Index& index, const boost::string_ref& name, uint32_t nameHash) const;
+    void insert(Index& index, Symbol symbol, uint32_t nameHash);
+
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<Entry>> mEntries;
+    std::atomic<Index*> mIndex;
+    std::atomic<size_t> mSize;
+    // NB - outgrown indices are kept, a lookup may still be probing one. Each is half the size of the next
+    std::vector<std::unique_ptr<Index>> mIndices;
+};
+
+}}
@@ -0,0 +1,35 @@
+//
+//  Transport.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "EventValue.h"
+#include "boost/asio.hpp"
+#include <functional>
+#include <vector>
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class Transport> TransportRef;
+
+// Carries a lemma's events in place of discovery, registration and the TCP sessions, which remain the default.
+class Transport {
+public:
+    typedef std::function<void(const boost::string_ref&, const EventValue&)> EventHandler;
+
+    virtual ~Transport() {}
+
+    // events named in hears are handed to eventHandler on io, the value is only valid for the duration of the call
+    virtual void open(const std::string& guestName, const std::vector<std::string>& hears, boost::asio::io_service& io, const EventHandler& eventHandler) = 0;
+    virtual void close() = 0;
+    virtual bool isOpen() const = 0;
+    // may be called from any thread, the value is copied if it has to outlive the call
+    virtual void send(const boost::string_ref& eventName, const EventValue& eventValue) = 0;
+};
+
+}}
@@ -0,0 +1,361 @@
+//
+//  WriteQueue.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "WriteQueue.h"
+#include "FrameDecoder.h"
+#include <algorithm>
+
+namespace Cinder { namespace Noam {
+
+static const size_t sDefaultFlushThreshold = 64 * 1024;
+static const size_t sCompactionThreshold = 16 * 1024;
+// bulk frames per write, at least one however long
+static const size_t sBulkSliceSize = 64 * 1024;
+
+// The gathered buffers as a sequence asio copies without allocating, where the vector itself would be copied into each
+//  write. NB - the vector is left alone while the write is in flight
+struct BufferRange {
+    typedef boost::asio::const_buffer value_type;
+    typedef const boost::asio::const_buffer* const_iterator;
+
+    explicit BufferRange(const std::vector<boost::asio::const_buffer>& buffers) : mBegin(buffers.data()), mEnd(buffers.data() + buffers.size()) {}
+
+    inline const_iterator begin() const { return mBegin; }
+    inline const_iterator end() const { return mEnd; }
+
+    const_iterator mBegin;
+    const_iterator mEnd;
+};
+
+WriteQueueRef WriteQueue::create(boost::asio::io_service& io) {
+    return WriteQueueRef(new WriteQueue(io));
+}
+
+WriteQueue::WriteQueue(boost::asio::io_service& io) : mIoService(io), mFlushTimer(io), mGeneration(0), mFlushWindow(0), mFlushThreshold(sDefaultFlushThreshold), mFlushPosted(false), mFlushTimerArmed(false), mWriting(false), mPendingBytes(0), mCommittedSize(0), mInFlightBytes(0), mCompressionThreshold(0), mBudgetBytes(0), mBudgetFrames(0), mLowWatermark(0), mHighWatermark(0), mAboveHighWatermark(false) {
+}
+
+#pragma mark -
+
+void WriteQueue::open(const TcpSocketRef& socket) {
+    close();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSocket = socket;
+}
+
+void WriteQueue::close() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSocket = nullptr;
+    mGeneration++;
+
+    mPending.clear();
+    for (std::vector<Frame>& frames : mPendingFrames) {
+        frames.clear();
+    }
+    mPendingBytes = 0;
+    mCommittedSize = 0;
+
+    boost::system::error_code err;
+    mFlushTimer.cancel(err);
+    mFlushTimerArmed = false;
+
+    mCompressionThreshold = 0;
+
+    updateWatermarks();
+}
+
+void WriteQueue::setCompressionThreshold(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (bytes && !mCompressor) {
+        mCompressor.reset(new Compressor());
+    }
+    mCompressionThreshold = bytes;
+}
+
+void WriteQueue::setBudget(size_t bytes, size_t frames) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mBudgetBytes = bytes;
+    mBudgetFrames = frames;
+}
+
+void WriteQueue::setWatermarks(size_t low, size_t high) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mLowWatermark = std::min(low, high);
+    mHighWatermark = high;
+    updateWatermarks();
+}
+
+SendStatus WriteQueue::commit(size_t conflationKey, Lane lane, bool budgeted) {
+    size_t offset = mPending.getFrameOffset();
+    if (offset < mCommittedSize || mPending.getSize() <= offset) {
+        // nothing encoded or the frame was discarded by endFrame()
+        return SendStatus::Rejected;
+    }
+    if (!mSocket) {
+        mPending.clear();
+        mStats.dropped++;
+        return SendStatus::Rejected;
+    }
+
+    if (mCompressionThreshold && mPending.getSize() - offset - FrameDecoder::sPrefixLength >= mCompressionThreshold) {
+        compress(offset);
+    }
+
+    Frame frame = {offset, mPending.getSize() - offset, conflationKey};
+    mCommittedSize = mPending.getSize();
+    SendStatus status = SendStatus::Conflated;
+    std::vector<Frame>& frames = mPendingFrames[static_cast<size_t>(lane)];
+    if (conflationKey == 0 || !conflate(frames, frame)) {
+        if (budgeted && isOverBudget(frame.length)) {
+            mPending.discardFrame();
+            mCommittedSize = mPending.getSize();
+            mStats.rejected++;
+            return SendStatus::Rejected;
+        }
+        frames.push_back(frame);
+        mPendingBytes += frame.length;
+        status = SendStatus::Accepted;
+    }
+
+    updateWatermarks();
+    scheduleFlush(lane == Lane::Control || mPendingBytes >= mFlushThreshold);
+    return status;
+}
+
+WriteQueue::Snapshot WriteQueue::getSnapshot() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Snapshot snapshot;
+    snapshot.stats = mStats;
+    snapshot.pendingFrameCount = getPendingFrameCount();
+    snapshot.queuedByteCount = getQueuedByteCount();
+    return snapshot;
+}
+
+#pragma mark -
+
+void WriteQueue::compress(size_t offset) {
+    const char* payload = mPending.getData() + offset + FrameDecoder::sPrefixLength;
+    size_t size = mPending.getSize() - offset - FrameDecoder::sPrefixLength;
+    if (payload[0] == Compressor::sFrameMarker || !mCompressor->compress(payload, size)) {
+        // already compressed or would not get any smaller
+        return;
+    }
+
+    mPending.discardFrame();
+    mPending.beginFrame();
+    mPending.appendRaw(Compressor::sFrameMarker);
+    mPending.appendRaw(mCompressor->getData(), mCompressor->getSize());
+    mPending.endFrame();
+    mStats.compressed++;
+    mStats.compressionSavedBytes += size - mCompressor->getSize() - 1;
+}
+
+bool WriteQueue::conflate(std::vector<Frame>& frames, const Frame& frame) {
+    // NB - a linear scan, conflated event names are few and the pending list is short lived
+    for (Frame& pendingFrame : frames) {
+        if (pendingFrame.conflationKey != frame.conflationKey) {
+            continue;
+        }
+
+        // the older bytes stay behind in the encoder until the next flush or compaction
+        mPendingBytes = mPendingBytes - pendingFrame.length + frame.length;
+        pendingFrame.offset = frame.offset;
+        pendingFrame.length = frame.length;
+        mStats.conflated++;
+
+        if (mPending.getSize() - mPendingBytes > std::max(mPendingBytes, sCompactionThreshold)) {
+            compact();
+        }
+        return true;
+    }
+    return false;
+}
+
+void WriteQueue::compact() {
+    mCompacted.clear();
+    for (std::vector<Frame>& frames : mPendingFrames) {
+        for (Frame& frame : frames) {
+            size_t offset = mCompacted.getSize();
+            mCompacted.appendRaw(mPending.getData() + frame.offset, frame.length);
+            frame.offset = offset;
+        }
+    }
+    std::swap(mPending, mCompacted);
+    mCommittedSize = mPending.getSize();
+}
+
+bool WriteQueue::isOverBudget(size_t length) const {
+    size_t frames = getQueuedFrameCount();
+    if (frames == 0) {
+        return false;
+    }
+    return (mBudgetFrames && frames + 1 > mBudgetFrames) || (mBudgetBytes && getQueuedByteCount() + length > mBudgetBytes);
+}
+
+void WriteQueue::updateWatermarks() {
+    size_t bytes = getQueuedByteCount();
+    bool above = mAboveHighWatermark;
+    if (!above && mHighWatermark && bytes >= mHighWatermark) {
+        above = true;
+    } else if (above && (!mHighWatermark || bytes <= mLowWatermark)) {
+        above = false;
+    }
+    if (above == mAboveHighWatermark) {
+        return;
+    }
+
+    mAboveHighWatermark = above;
+    WriteQueueRef queue = shared_from_this();
+    mIoService.post([queue, above]() {
+        const std::function<void()>& eventHandler = above ? queue->mHighWatermarkEventHandler : queue->mLowWatermarkEventHandler;
+        if (eventHandler) {
+            eventHandler();
+        }
+    });
+}
+
+void WriteQueue::scheduleFlush(bool immediate) {
+    if (mWriting || mFlushPosted) {
+        // NB - an in flight write picks up pending frames as it completes
+        return;
+    }
+
+    WriteQueueRef queue = shared_from_this();
+    size_t generation = mGeneration;
+    if (immediate || mFlushWindow == 0) {
+        if (mFlushTimerArmed) {
+            boost::system::error_code err;
+            mFlushTimer.cancel(err);
+            mFlushTimerArmed = false;
+        }
+        mFlushPosted = true;
+        mIoService.post(makeAllocatingHandler(mFlushHandlerMemory, [queue, generation]() {
+            std::lock_guard<std::mutex> lock(queue->mMutex);
+            queue->mFlushPosted = false;
+            if (generation == queue->mGeneration) {
+                queue->flush();
+            }
+        }));
+    } else if (!mFlushTimerArmed) {
+        mFlushTimerArmed = true;
+        mFlushTimer.expires_from_now(boost::posix_time::milliseconds(mFlushWindow));
+        mFlushTimer.async_wait(makeAllocatingHandler(mTimerHandlerMemory, [queue, generation](const boost::system::error_code& err) {
+            if (err) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(queue->mMutex);
+            queue->mFlushTimerArmed = false;
+            if (generation == queue->mGeneration) {
+                queue->flush();
+            }
+        }));
+    }
+}
+
+void WriteQueue::flush() {
+    if (mWriting || getPendingFrameCount() == 0 || !mSocket) {
+        return;
+    }
+
+    // control and interactive frames all go, bulk ones up to a slice
+    std::vector<Frame>& bulkFrames = mPendingFrames[static_cast<size_t>(Lane::Bulk)];
+    size_t bulkCount = 0;
+    size_t bulkBytes = 0;
+    while (bulkCount < bulkFrames.size() && (bulkCount == 0 || bulkBytes + bulkFrames[bulkCount].length <= sBulkSliceSize)) {
+        bulkBytes += bulkFrames[bulkCount++].length;
+    }
+
+    mInFlightFrames.clear();
+    if (bulkCount == bulkFrames.size()) {
+        // the pending frames become the in flight write, the other encoder keeps its capacity for the next batch
+        std::swap(mPending, mInFlight);
+        for (std::vector<Frame>& frames : mPendingFrames) {
+            mInFlightFrames.insert(mInFlightFrames.end(), frames.begin(), frames.end());
+            frames.clear();
+        }
+        mInFlightBytes = mPendingBytes;
+        mPending.clear();
+        mPendingBytes = 0;
+        mCommittedSize = 0;
+    } else {
+        // bulk frames are left behind, what goes is copied out and leaves a hole until the next compaction
+        mInFlight.clear();
+        mInFlightBytes = 0;
+        for (size_t lane = 0; lane < mPendingFrames.size(); lane++) {
+            std::vector<Frame>& frames = mPendingFrames[lane];
+            size_t count = lane == static_cast<size_t>(Lane::Bulk) ? bulkCount : frames.size();
+            for (size_t idx = 0; idx < count; idx++) {
+                Frame frame = frames[idx];
+                mInFlight.appendRaw(mPending.getData() + frame.offset, frame.length);
+                frame.offset = mInFlight.getSize() - frame.length;
+                mInFlightFrames.push_back(frame);
+                mInFlightBytes += frame.length;
+            }
+            frames.erase(frames.begin(), frames.begin() + count);
+        }
+        mPendingBytes -= mInFlightBytes;
+        if (mPending.getSize() - mPendingBytes > std::max(mPendingBytes, sCompactionThreshold)) {
+            compact();
+        }
+    }
+
+    // gather, coalescing frames that are adjacent in the encoder
+    mBuffers.clear();
+    size_t start = mInFlightFrames.front().offset;
+    size_t end = start;
+    for (const Frame& frame : mInFlightFrames) {
+        if (frame.offset != end) {
+            mBuffers.push_back(boost::asio::const_buffer(mInFlight.getData() + start, end - start));
+            start = frame.offset;
+        }
+        end = frame.offset + frame.length;
+    }
+    mBuffers.push_back(boost::asio::const_buffer(mInFlight.getData() + start, end - start));
+
+    mStats.writes++;
+    mStats.frames += mInFlightFrames.size();
+
+    mWriting = true;
+    WriteQueueRef queue = shared_from_this();
+    size_t generation = mGeneration;
+    boost::asio::async_write(*mSocket, BufferRange(mBuffers), makeAllocatingHandler(mWriteHandlerMemory, [queue, generation](const boost::system::error_code& err, size_t bytesTransferred) {
+        queue->onWrite(generation, err, bytesTransferred);
+    }));
+}
+
+void WriteQueue::onWrite(size_t generation, const boost::system::error_code& err, size_t bytesTransferred) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWriting = false;
+    mInFlight.clear();
+    mInFlightFrames.clear();
+    mInFlightBytes = 0;
+    updateWatermarks();
+
+    if (generation != mGeneration) {
+        // closed while in flight, pick up whatever a newly opened socket has pending
+        flush();
+        return;
+    }
+
+    if (!err) {
+        mStats.bytes += bytesTransferred;
+        flush();
+    }
+
+    // NB - handlers are called without the lock, they may well commit frames of their own
+    lock.unlock();
+    if (err) {
+        if (mErrorEventHandler) {
+            mErrorEventHandler(err.message(), bytesTransferred);
+        }
+    } else if (mWriteEventHandler) {
+        mWriteEventHandler(bytesTransferred);
+    }
+}
+
+}}
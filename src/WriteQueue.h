@@ -0,0 +1,185 @@
+//
+//  WriteQueue.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include "TcpSession.h"
+#include "FrameEncoder.h"
+#include "Compressor.h"
+#include "HandlerMemory.h"
+#include <array>
+#include <mutex>
+
+namespace Cinder { namespace Noam {
+
+typedef std::shared_ptr<class WriteQueue> WriteQueueRef;
+
+// what became of a frame handed over to be sent
+enum class SendStatus {
+    // queued, or buffered until there is a host
+    Accepted,
+    // replaced an older unsent value of the same event
+    Conflated,
+    // dropped, over budget, without a host or too long
+    Rejected
+};
+
+// outbound priority classes, each write takes the pending control frames first, then interactive and then bulk ones
+enum class Lane {
+    // registration and heartbeats, never held to the budget nor kept waiting for the flush window
+    Control,
+    // events, by default
+    Interactive,
+    // large or bursty events, written a slice at a time so the other lanes never wait on more than one slice
+    Bulk
+};
+
+// Outbound frames for a TCP session. Frames committed during one io_service turn, or within the flush window, are gathered
+//  into a single write and only one write is ever in flight; frames committed meanwhile go out with the next one.
+//  Frames committed with a conflation key replace a pending frame with the same key in place rather than queueing behind it.
+//  Frames can be encoded and committed from any thread while holding getMutex(), writes are only ever issued on the io_service.
+//  Once the peer has agreed to it, frames above the compression threshold are deflated as they are committed.
+//  Budgeted frames are turned away once the frames queued and in flight exceed the budget, rather than piling up unseen.
+//  Frames are queued per lane and a lane is written in the order committed, yet one lane may overtake another.
+class WriteQueue : public std::enable_shared_from_this<WriteQueue> {
+public:
+    struct Stats {
+        Stats() : writes(0), frames(0), bytes(0), conflated(0), dropped(0), rejected(0), compressed(0), compressionSavedBytes(0) {}
+        inline double getFramesPerWrite() const { return writes ? static_cast<double>(frames) / writes : 0.0; }
+
+        uint64_t writes;
+        uint64_t frames;
+        uint64_t bytes;
+        uint64_t conflated;
+        uint64_t dropped;
+        // over budget
+        uint64_t rejected;
+        uint64_t compressed;
+        uint64_t compressionSavedBytes;
+    };
+
+    // stats and queue depths as of one moment
+    struct Snapshot {
+        Stats stats;
+        size_t pendingFrameCount;
+        size_t queuedByteCount;
+    };
+
+    static WriteQueueRef create(boost::asio::io_service& io);
+
+    void open(const TcpSocketRef& socket);
+    // drops pending frames, a write in flight completes or is aborted by the socket closing. Compression is turned off,
+    //  it is agreed per connection
+    void close();
+
+    // 0 flushes at the end of the current io_service turn
+    void setFlushWindow(size_t millis) { mFlushWindow = millis; }
+    // pending bytes that trigger a flush right away, regardless of the window
+    void setFlushThreshold(size_t bytes) { mFlushThreshold = bytes; }
+    // frames at least this long are compressed, 0 turns compression off. Only once the peer supports it
+    void setCompressionThreshold(size_t bytes);
+    // bytes and frames, queued and in flight, past which budgeted frames are rejected, 0 for no limit. A frame is never
+    //  rejected while nothing else is queued, however long
+    void setBudget(size_t bytes, size_t frames = 0);
+    // once queued bytes reach high the high watermark handler is called, then the low one once they drain back down to
+    //  low. 0 turns them off
+    void setWatermarks(size_t low, size_t high);
+
+    // hold while encoding and committing
+    inline std::mutex& getMutex() { return mMutex; }
+    // encode a single frame with beginFrame()/endFrame() then commit() it
+    inline FrameEncoder& getEncoder() { return mPending; }
+    // a non-zero key identifies frames that supersede one another within a lane, replacing one never counts against the
+    //  budget
+    SendStatus commit(size_t conflationKey = 0, Lane lane = Lane::Interactive, bool budgeted = false);
+
+    inline bool isOpen() const { return static_cast<bool>(mSocket); }
+    inline bool isWriting() const { return mWriting; }
+    inline size_t getPendingFrameCount() const { return mPendingFrames[0].size() + mPendingFrames[1].size() + mPendingFrames[2].size(); }
+    inline size_t getPendingFrameCount(Lane lane) const { return mPendingFrames[static_cast<size_t>(lane)].size(); }
+    inline size_t getPendingByteCount() const { return mPendingBytes; }
+    // pending and in flight
+    inline size_t getQueuedFrameCount() const { return getPendingFrameCount() + mInFlightFrames.size(); }
+    inline size_t getQueuedByteCount() const { return mPendingBytes + mInFlightBytes; }
+    inline bool isAboveHighWatermark() const { return mAboveHighWatermark; }
+    inline const Stats& getStats() const { return mStats; }
+    // NB - the getters above change as frames are committed and written, hold getMutex() around them or take a snapshot
+    //  when reading from another thread
+    Snapshot getSnapshot() const;
+    // operations that could not use the queue's handler memory
+    inline uint64_t getHandlerAllocationCount() const {
+        return mWriteHandlerMemory.getFallbackCount() + mFlushHandlerMemory.getFallbackCount() + mTimerHandlerMemory.getFallbackCount();
+    }
+
+    void connectErrorEventHandler(const std::function<void(std::string, size_t)>& eventHandler) { mErrorEventHandler = eventHandler; }
+    void connectWriteEventHandler(const std::function<void(size_t)>& eventHandler) { mWriteEventHandler = eventHandler; }
+    // posted to the io_service rather than called from within commit(), so frames can be committed from either
+    void connectHighWatermarkEventHandler(const std::function<void()>& eventHandler) { mHighWatermarkEventHandler = eventHandler; }
+    void connectLowWatermarkEventHandler(const std::function<void()>& eventHandler) { mLowWatermarkEventHandler = eventHandler; }
+
+private:
+    struct Frame {
+        size_t offset;
+        size_t length;
+        size_t conflationKey;
+    };
+
+    WriteQueue(boost::asio::io_service& io);
+
+    void compress(size_t offset);
+    bool conflate(std::vector<Frame>& frames, const Frame& frame);
+    void compact();
+    bool isOverBudget(size_t length) const;
+    void updateWatermarks();
+    void scheduleFlush(bool immediate);
+    void flush();
+    void onWrite(size_t generation, const boost::system::error_code& err, size_t bytesTransferred);
+
+    mutable std::mutex mMutex;
+    boost::asio::io_service& mIoService;
+    boost::asio::deadline_timer mFlushTimer;
+    TcpSocketRef mSocket;
+    size_t mGeneration;
+    size_t mFlushWindow;
+    size_t mFlushThreshold;
+    bool mFlushPosted;
+    bool mFlushTimerArmed;
+    bool mWriting;
+
+    FrameEncoder mPending;
+    std::array<std::vector<Frame>, 3> mPendingFrames;
+    size_t mPendingBytes;
+    size_t mCommittedSize;
+    FrameEncoder mCompacted;
+    FrameEncoder mInFlight;
+    std::vector<Frame> mInFlightFrames;
+    size_t mInFlightBytes;
+    std::vector<boost::asio::const_buffer> mBuffers;
+
+    std::unique_ptr<Compressor> mCompressor;
+    size_t mCompressionThreshold;
+
+    size_t mBudgetBytes;
+    size_t mBudgetFrames;
+    size_t mLowWatermark;
+    size_t mHighWatermark;
+    bool mAboveHighWatermark;
+
+    HandlerMemory mWriteHandlerMemory;
+    HandlerMemory mFlushHandlerMemory;
+    HandlerMemory mTimerHandlerMemory;
+
+    Stats mStats;
+
+    std::function<void(std::string, size_t)> mErrorEventHandler;
+    std::function<void(size_t)> mWriteEventHandler;
+    std::function<void()> mHighWatermarkEventHandler;
+    std::function<void()> mLowWatermarkEventHandler;
+};
+
+}}
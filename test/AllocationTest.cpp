@@ -0,0 +1,97 @@
+//
+//  AllocationTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "FrameReader.h"
+#include "WriteQueue.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace Cinder::Noam;
+
+static const int sWarmUpFrames = 1000;
+static const int sFrames = 20 * 1000;
+
+static std::atomic<uint64_t> sAllocationCount(0);
+
+void* operator new(size_t size) {
+    sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+static void commitFrame(const WriteQueueRef& queue, int64_t value) {
+    std::lock_guard<std::mutex> lock(queue->getMutex());
+    FrameEncoder& encoder = queue->getEncoder();
+    encoder.beginFrame();
+    encoder.appendRaw("[\"event\",\"guest\",\"Count\",", 25);
+    encoder.appendValue(value);
+    encoder.appendRaw(']');
+    encoder.endFrame();
+    queue->commit();
+}
+
+// frames written and read back over a loopback connection, once warmed up neither side allocates, not even within asio
+static void testSteadyState() {
+    boost::asio::io_service io;
+    boost::asio::ip::tcp::acceptor acceptor(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    TcpSocketRef client = std::make_shared<boost::asio::ip::tcp::socket>(io);
+    TcpSocketRef server = std::make_shared<boost::asio::ip::tcp::socket>(io);
+    client->connect(acceptor.local_endpoint());
+    acceptor.accept(*server);
+
+    WriteQueueRef queue = WriteQueue::create(io);
+    FrameReaderRef reader = FrameReader::create();
+    int64_t received = 0;
+    size_t frameSize = 0;
+    reader->connectFrameEventHandler([&](const boost::string_ref& frame) {
+        received++;
+        frameSize = frame.size();
+    });
+    queue->open(client);
+    reader->open(server);
+
+    // one frame per turn and bursts gathered into a single write, each read back before the next
+    int64_t sent = 0;
+    auto exchange = [&](int frames) {
+        for (int round = 0; round < frames; round++) {
+            for (int idx = 0; idx < 1 + round % 16; idx++) {
+                commitFrame(queue, sent++);
+            }
+            while (received < sent) {
+                io.run_one();
+            }
+        }
+    };
+
+    exchange(sWarmUpFrames);
+    uint64_t allocationStartCount = sAllocationCount;
+    exchange(sFrames);
+    uint64_t allocations = sAllocationCount - allocationStartCount;
+
+    NOAM_CHECK(received == sent);
+    NOAM_CHECK(frameSize > 0);
+    NOAM_CHECK(allocations == 0);
+    NOAM_CHECK(queue->getHandlerAllocationCount() == 0);
+    NOAM_CHECK(reader->getHandlerAllocationCount() == 0);
+
+    reader->close();
+    queue->close();
+}
+
+int main(int argc, const char* argv[]) {
+    testSteadyState();
+    return Check::finish("AllocationTest");
+}
@@ -0,0 +1,37 @@
+//
+//  Check.h
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#pragma once
+
+#include <iostream>
+
+// Each test is a plain executable, failed checks are reported as they happen and main() returns getFailureCount() so
+//  CTest sees a non-zero exit.
+namespace Cinder { namespace Noam { namespace Check {
+
+inline size_t& getFailureCount() {
+    static size_t sFailureCount = 0;
+    return sFailureCount;
+}
+
+inline bool report(bool passed, const char* expression, const char* file, int line) {
+    if (!passed) {
+        getFailureCount()++;
+        std::cerr << file << ":" << line << ": check failed - " << expression << std::endl;
+    }
+    return passed;
+}
+
+inline int finish(const char* name) {
+    std::cout << name << (getFailureCount() ? " FAILED, " : " passed, ") << getFailureCount() << " failed checks" << std::endl;
+    return getFailureCount() ? 1 : 0;
+}
+
+}}}
+
+#define NOAM_CHECK(expression) Cinder::Noam::Check::report(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,164 @@
+//
+//  EventQueueTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "EventQueue.h"
+#include "Lemma.h"
+#include "LoopbackTransport.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+using namespace Cinder::Noam;
+
+static const size_t sProducerCount = 4;
+static const size_t sEventsPerProducer = 200 * 1000;
+
+static double getPercentile(std::vector<double>& samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+}
+
+// producers push as fast as they can, retrying when full, while the consumer drains. Every event arrives once, intact and
+//  in the order its producer pushed it
+static void testProducersAndConsumer() {
+    EventQueue queue(1024);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < sProducerCount; producer++) {
+        producers.push_back(std::thread([&queue, producer]() {
+            std::string eventName = "Producer" + std::to_string(producer);
+            for (size_t idx = 0; idx < sEventsPerProducer; idx++) {
+                // NB - odd events carry a string so slots switch between types and reuse their capacity
+                std::string text = idx % 2 ? "payload " + std::to_string(idx) : std::string();
+                EventValue value = idx % 2 ? EventValue::makeString(text, boost::string_ref()) : EventValue::makeInt(static_cast<int64_t>(idx), boost::string_ref());
+                while (!queue.push(eventName, value)) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    std::vector<size_t> nextIndex(sProducerCount, 0);
+    std::vector<double> latencies;
+    latencies.reserve(sProducerCount * sEventsPerProducer);
+    size_t received = 0;
+    bool intact = true;
+    while (received < sProducerCount * sEventsPerProducer) {
+        QueuedEvent* event = queue.front();
+        if (!event) {
+            std::this_thread::yield();
+            continue;
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - event->getEnqueueTime()).count());
+
+        size_t producer = static_cast<size_t>(std::stoul(event->getEventName().substr(8)));
+        size_t idx = nextIndex[producer]++;
+        EventValue value = event->getEventValue();
+        if (idx % 2) {
+            intact &= value.getType() == EventValue::Type::String && value.asString() == "payload " + std::to_string(idx);
+        } else {
+            intact &= value.getType() == EventValue::Type::Int && value.asInt() == static_cast<int64_t>(idx);
+        }
+        queue.pop();
+        received++;
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    NOAM_CHECK(intact);
+    NOAM_CHECK(queue.front() == nullptr);
+    for (size_t count : nextIndex) {
+        NOAM_CHECK(count == sEventsPerProducer);
+    }
+    std::printf("EventQueue  %zu producers  %9.0f events/s  queue latency p50 %7.1f us  p99 %7.1f us\n", sProducerCount, received / elapsed, getPercentile(latencies, 0.5), getPercentile(latencies, 0.99));
+}
+
+static void testFullQueueDrops() {
+    EventQueue queue(8);
+    size_t pushed = 0;
+    while (queue.push("Full", EventValue::makeInt(static_cast<int64_t>(pushed), boost::string_ref()))) {
+        pushed++;
+    }
+    NOAM_CHECK(pushed == queue.getCapacity());
+    NOAM_CHECK(queue.getDroppedCount() == 1);
+
+    // a slot freed is a slot to push into again
+    queue.pop();
+    NOAM_CHECK(queue.push("Full", EventValue::makeInt(-1, boost::string_ref())));
+    NOAM_CHECK(queue.front()->getEventValue().asInt() == 1);
+}
+
+// the threaded receive path end to end, events arrive on the receiver's I/O thread and wait for poll() while the app
+//  thread keeps adding and removing handlers, which the I/O thread checks every event against
+static void testThreadedReceive() {
+    LoopbackHubRef hub = LoopbackHub::create();
+    LemmaRef sender = Lemma::create("sender", "", Lemma::Format().threaded());
+    LemmaRef receiver = Lemma::create("receiver", "", Lemma::Format().threaded().eventQueueCapacity(4096));
+
+    // NB - read by the producer to pace itself
+    std::atomic<int64_t> expected(0);
+    bool ordered = true;
+    receiver->connectMessageEventHandler("Count", [&](const std::string&, const EventValue& eventValue) {
+        ordered &= eventValue.asInt() == expected;
+        expected++;
+    });
+    sender->begin(hub->createTransport(4096));
+    receiver->begin(hub->createTransport(4096));
+    while (!sender->isConnected() || !receiver->isConnected()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::thread producer([&]() {
+        for (int idx = 0; idx < 100 * 1000; idx++) {
+            sender->sendMessage("Count", idx);
+            // NB - kept within the queues rather than racing ahead of poll()
+            while (idx - expected > 2000) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t churn = 0;
+    std::vector<size_t> handlerIds;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    while (expected < 100 * 1000 && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(30)) {
+        // new names grow the tables, a second handler for the heard event and a prefix come and go
+        handlerIds.push_back(receiver->addMessageEventHandler("Churn" + std::to_string(churn % 512), [](const std::string&, const EventValue&) {}));
+        handlerIds.push_back(receiver->addMessageEventHandler(churn % 2 ? "Count" : "Cou*", [](const std::string&, const EventValue&) {}));
+        if (handlerIds.size() > 64) {
+            for (size_t handlerId : handlerIds) {
+                receiver->removeMessageEventHandler(handlerId);
+            }
+            handlerIds.clear();
+        }
+        churn++;
+        receiver->poll(256);
+    }
+    producer.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    Lemma::QueueStats stats = receiver->getQueueStats();
+    NOAM_CHECK(expected == 100 * 1000);
+    NOAM_CHECK(ordered);
+    NOAM_CHECK(stats.dropped == 0);
+    std::printf("threaded receive  %9.0f events/s  queue latency mean %7.1f us  max %7.1f us  %zu handler changes\n", stats.dispatched / elapsed, stats.getAverageLatency() * 1.0e6, stats.maxLatency * 1.0e6, churn * 2);
+}
+
+int main(int argc, const char* argv[]) {
+    testProducersAndConsumer();
+    testFullQueueDrops();
+    testThreadedReceive();
+    return Check::finish("EventQueueTest");
+}
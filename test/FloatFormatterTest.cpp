@@ -0,0 +1,113 @@
+//
+//  FloatFormatterTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "FloatFormatter.h"
+#include "FrameEncoder.h"
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace Cinder::Noam;
+
+template <typename T>
+static std::string format(T value) {
+    char buffer[FloatFormatter::sMaxLength];
+    return std::string(buffer, FloatFormatter::format(value, buffer));
+}
+
+static bool readsBack(double value) {
+    double parsed = std::strtod(format(value).c_str(), nullptr);
+    return std::memcmp(&parsed, &value, sizeof(value)) == 0;
+}
+
+static bool readsBack(float value) {
+    float parsed = std::strtof(format(value).c_str(), nullptr);
+    return std::memcmp(&parsed, &value, sizeof(value)) == 0;
+}
+
+static void testLayout() {
+    NOAM_CHECK(format(0.0) == "0");
+    NOAM_CHECK(format(-0.0) == "-0");
+    NOAM_CHECK(format(42.0) == "42");
+    NOAM_CHECK(format(-1.5) == "-1.5");
+    NOAM_CHECK(format(0.1) == "0.1");
+    NOAM_CHECK(format(1.0 / 3.0) == "0.3333333333333333");
+    NOAM_CHECK(format(123456.789) == "123456.789");
+    NOAM_CHECK(format(1e20) == "100000000000000000000");
+    NOAM_CHECK(format(1e21) == "1e+21");
+    NOAM_CHECK(format(0.000001) == "0.000001");
+    NOAM_CHECK(format(1e-7) == "1e-7");
+    NOAM_CHECK(format(1.5e-300) == "1.5e-300");
+    NOAM_CHECK(format(std::numeric_limits<double>::max()) == "1.7976931348623157e+308");
+    NOAM_CHECK(format(std::numeric_limits<double>::min()) == "2.2250738585072014e-308");
+    NOAM_CHECK(format(std::numeric_limits<double>::denorm_min()) == "5e-324");
+
+    // the shortest float, not the float widened to a double
+    NOAM_CHECK(format(0.1f) == "0.1");
+    NOAM_CHECK(format(1.0f / 3.0f) == "0.33333334");
+    NOAM_CHECK(format(16777216.0f) == "16777216");
+    NOAM_CHECK(format(std::numeric_limits<float>::max()) == "3.4028235e+38");
+    NOAM_CHECK(format(std::numeric_limits<float>::denorm_min()) == "1e-45");
+}
+
+static void testRoundTrip() {
+    std::mt19937_64 random(1030);
+    // NB - random bit patterns cover every exponent, subnormals included
+    for (int idx = 0; idx < 200000; idx++) {
+        uint64_t bits = random();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value)) {
+            NOAM_CHECK(readsBack(value));
+            // NB - at most 17 digits, the longest layout being e.g. -0.0000010568159620845687
+            NOAM_CHECK(format(value).size() <= 25);
+        }
+
+        uint32_t floatBits = static_cast<uint32_t>(bits >> 32);
+        float floatValue;
+        std::memcpy(&floatValue, &floatBits, sizeof(floatValue));
+        if (std::isfinite(floatValue)) {
+            NOAM_CHECK(readsBack(floatValue));
+        }
+    }
+
+    // values as they are typically sent, e.g. coordinates and sensor readings
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    for (int idx = 0; idx < 200000; idx++) {
+        double value = distribution(random);
+        NOAM_CHECK(readsBack(value));
+        NOAM_CHECK(readsBack(static_cast<float>(value)));
+    }
+}
+
+static void testLocale() {
+    // NB - skipped where no locale with a decimal comma is installed
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE", "fr_FR"};
+    for (const char* locale : locales) {
+        if (std::setlocale(LC_NUMERIC, locale)) {
+            FrameEncoder encoder;
+            encoder.appendValue(0.5);
+            encoder.appendRaw(',');
+            encoder.appendValue(2.25f);
+            NOAM_CHECK(std::string(encoder.getData(), encoder.getSize()) == "0.5,2.25");
+            std::setlocale(LC_NUMERIC, "C");
+            return;
+        }
+    }
+}
+
+int main(int argc, const char* argv[]) {
+    testLayout();
+    testRoundTrip();
+    testLocale();
+    return Check::finish("FloatFormatterTest");
+}
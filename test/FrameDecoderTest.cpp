@@ -0,0 +1,209 @@
+//
+//  FrameDecoderTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "FrameDecoder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace Cinder::Noam;
+
+struct Decoded {
+    std::vector<std::string> frames;
+    FrameDecoder::Status status;
+    size_t bufferedSize;
+};
+
+static std::string makeFrame(const std::string& json) {
+    char prefix[FrameDecoder::sPrefixLength + 1];
+    std::snprintf(prefix, sizeof(prefix), "%06zu", json.size());
+    return prefix + json;
+}
+
+// the stream cut at each offset in splits, fed one read at a time or, when prepared, read into the decoder's own buffer
+//  as FrameReader does
+static Decoded decode(FrameDecoder& decoder, const std::string& stream, const std::vector<size_t>& splits, bool prepared) {
+    Decoded decoded;
+    decoded.status = FrameDecoder::Status::NeedMoreData;
+
+    size_t offset = 0;
+    for (size_t idx = 0; idx <= splits.size(); idx++) {
+        size_t end = idx < splits.size() ? splits[idx] : stream.size();
+        const char* data = stream.data() + offset;
+        size_t size = end - offset;
+        offset = end;
+
+        if (prepared) {
+            std::memcpy(decoder.prepare(size), data, size);
+            decoder.commit(size);
+        } else {
+            decoder.feed(data, size);
+        }
+
+        boost::string_ref frame;
+        while ((decoded.status = decoder.next(frame)) == FrameDecoder::Status::Frame) {
+            decoded.frames.push_back(std::string(frame.data(), frame.size()));
+        }
+        if (decoded.status == FrameDecoder::Status::Error) {
+            break;
+        }
+    }
+    decoded.bufferedSize = decoder.getBufferedSize();
+    return decoded;
+}
+
+static Decoded decode(const std::string& stream, const std::vector<size_t>& splits, bool prepared, size_t initialCapacity = 64 * 1024) {
+    FrameDecoder decoder(initialCapacity);
+    return decode(decoder, stream, splits, prepared);
+}
+
+static void testEverySplitPoint() {
+    // empty, short and long frames back to back, small enough to also cut at every pair of points
+    std::vector<std::string> frames = {"[\"event\",\"a\",\"b\",1]", "", "[\"heartbeat\",\"guest\"]", std::string(300, 'x'), "{}"};
+    std::string stream;
+    for (const std::string& frame : frames) {
+        stream += makeFrame(frame);
+    }
+
+    for (bool prepared : {false, true}) {
+        for (size_t split = 0; split <= stream.size(); split++) {
+            Decoded decoded = decode(stream, {split}, prepared);
+            NOAM_CHECK(decoded.status == FrameDecoder::Status::NeedMoreData);
+            NOAM_CHECK(decoded.frames == frames);
+            NOAM_CHECK(decoded.bufferedSize == 0);
+        }
+
+        // NB - a small initial capacity has the carry buffer wrap and grow along the way
+        for (size_t first = 0; first <= stream.size(); first++) {
+            for (size_t second = first; second <= stream.size(); second += 7) {
+                Decoded decoded = decode(stream, {first, second}, prepared, 16);
+                NOAM_CHECK(decoded.status == FrameDecoder::Status::NeedMoreData);
+                NOAM_CHECK(decoded.frames == frames);
+            }
+        }
+
+        // a byte per read, every prefix split at every digit
+        std::vector<size_t> splits;
+        for (size_t offset = 1; offset < stream.size(); offset++) {
+            splits.push_back(offset);
+        }
+        Decoded decoded = decode(stream, splits, prepared, 8);
+        NOAM_CHECK(decoded.frames == frames);
+    }
+}
+
+static void testRandomSplits() {
+    std::mt19937 random(1030);
+    std::uniform_int_distribution<size_t> lengthDistribution(0, 2000);
+    std::uniform_int_distribution<int> charDistribution('a', 'z');
+
+    for (int round = 0; round < 200; round++) {
+        std::vector<std::string> frames(1 + round % 20);
+        std::string stream;
+        for (std::string& frame : frames) {
+            frame.resize(lengthDistribution(random));
+            for (char& c : frame) {
+                c = static_cast<char>(charDistribution(random));
+            }
+            stream += makeFrame(frame);
+        }
+
+        std::vector<size_t> splits;
+        std::uniform_int_distribution<size_t> splitDistribution(0, stream.size());
+        for (int idx = 0; idx < round % 32; idx++) {
+            splits.push_back(splitDistribution(random));
+        }
+        std::sort(splits.begin(), splits.end());
+
+        Decoded decoded = decode(stream, splits, round % 2 == 0, 64);
+        NOAM_CHECK(decoded.frames == frames);
+        NOAM_CHECK(decoded.bufferedSize == 0);
+    }
+}
+
+static void testPartialPrefixAtEnd() {
+    for (bool prepared : {false, true}) {
+        FrameDecoder decoder;
+        std::string stream = makeFrame("hello") + "0000";
+        Decoded decoded = decode(decoder, stream, {}, prepared);
+        NOAM_CHECK(decoded.status == FrameDecoder::Status::NeedMoreData);
+        NOAM_CHECK(decoded.frames == std::vector<std::string>({"hello"}));
+        // the partial prefix is carried rather than dropped or taken for an error
+        NOAM_CHECK(decoded.bufferedSize == 4);
+
+        decoded = decode(decoder, std::string("03abc"), {}, prepared);
+        NOAM_CHECK(decoded.status == FrameDecoder::Status::NeedMoreData);
+        NOAM_CHECK(decoded.frames == std::vector<std::string>({"abc"}));
+        NOAM_CHECK(decoded.bufferedSize == 0);
+
+        // a whole prefix with nothing after it yet
+        decoded = decode(decoder, std::string("000002"), {}, prepared);
+        NOAM_CHECK(decoded.frames.empty());
+        NOAM_CHECK(decoded.bufferedSize == FrameDecoder::sPrefixLength);
+        decoded = decode(decoder, std::string("{}"), {}, prepared);
+        NOAM_CHECK(decoded.frames == std::vector<std::string>({"{}"}));
+    }
+}
+
+static void testBadPrefixes() {
+    std::vector<std::string> prefixes = {"00001x", "-00001", " 00001", "+00001", "0x0010", "abcdef", std::string("000") + '\0' + "01"};
+    for (const std::string& prefix : prefixes) {
+        std::string stream = makeFrame("ok") + prefix + "{}" + makeFrame("never");
+        for (bool prepared : {false, true}) {
+            for (size_t split = 0; split <= stream.size(); split++) {
+                FrameDecoder decoder(16);
+                Decoded decoded = decode(decoder, stream, {split}, prepared);
+                NOAM_CHECK(decoded.status == FrameDecoder::Status::Error);
+                NOAM_CHECK(decoded.frames == std::vector<std::string>({"ok"}));
+                NOAM_CHECK(!decoder.getError().empty());
+
+                // the stream can no longer be framed, only a reset gets the decoder going again
+                boost::string_ref frame;
+                decoder.feed(stream.data(), stream.size());
+                NOAM_CHECK(decoder.next(frame) == FrameDecoder::Status::Error);
+                decoder.reset();
+                NOAM_CHECK(decoder.getError().empty());
+                decoded = decode(decoder, makeFrame("again"), {}, prepared);
+                NOAM_CHECK(decoded.frames == std::vector<std::string>({"again"}));
+            }
+        }
+    }
+}
+
+static void testOversizedFrames() {
+    // the longest frame the prefix can describe, carried across reads far larger than the initial capacity
+    std::string largest(FrameDecoder::sMaxFrameLength, 'y');
+    std::string stream = makeFrame(largest) + makeFrame("after");
+    for (bool prepared : {false, true}) {
+        Decoded decoded = decode(stream, {3, 1000, 500000, stream.size() - 8}, prepared, 1024);
+        NOAM_CHECK(decoded.status == FrameDecoder::Status::NeedMoreData);
+        NOAM_CHECK(decoded.frames.size() == 2 && decoded.frames[0] == largest && decoded.frames[1] == "after");
+    }
+
+    // a prefix claiming more than is ever sent leaves the bytes buffered, it is not mistaken for a frame
+    FrameDecoder decoder(1024);
+    std::string truncated = "999999" + std::string(5000, 'z');
+    Decoded decoded = decode(decoder, truncated, {100, 2000}, true);
+    NOAM_CHECK(decoded.status == FrameDecoder::Status::NeedMoreData);
+    NOAM_CHECK(decoded.frames.empty());
+    NOAM_CHECK(decoded.bufferedSize == truncated.size());
+    // NB - 7 digits are a 6 digit length followed by a byte of JSON, the frame is 1 byte short of complete
+    decoded = decode(std::string("1000000") + std::string(99998, '0'), {}, false);
+    NOAM_CHECK(decoded.frames.empty() && decoded.bufferedSize == 100005);
+}
+
+int main(int argc, const char* argv[]) {
+    testEverySplitPoint();
+    testRandomSplits();
+    testPartialPrefixAtEnd();
+    testBadPrefixes();
+    testOversizedFrames();
+    return Check::finish("FrameDecoderTest");
+}
@@ -0,0 +1,134 @@
+//
+//  HostCacheTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "Host.h"
+#include "Lemma.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace Cinder::Noam;
+
+static const uint16_t sHostPort = 7745;
+// where the host was last time, nothing listens there now. NB - outside the ephemeral range, a port picked by the system
+//  can come back as the lemma's own and connect to itself
+static const uint16_t sStaleHostPort = 7746;
+// where the host was last time, someone else has the address now and does not answer
+static const uint16_t sUnresponsiveHostPort = 7747;
+static const char* sRoomName = "host_cache_test";
+
+static void writeHostCache(const ci::fs::path& path, uint16_t port) {
+    std::ofstream stream(path.string().c_str(), std::ios::trunc);
+    stream << "127.0.0.1 " << port << std::endl;
+}
+
+static uint16_t readHostCachePort(const ci::fs::path& path) {
+    std::ifstream stream(path.string().c_str());
+    std::string host;
+    uint16_t port = 0;
+    stream >> host >> port;
+    return port;
+}
+
+// a listener whose backlog is full, connection attempts get no answer at all rather than being refused, as they would
+//  from an address handed to a machine that drops them
+static std::shared_ptr<boost::asio::ip::tcp::acceptor> createUnresponsiveListener(boost::asio::io_service& io, std::vector<TcpSocketRef>& pending) {
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), sUnresponsiveHostPort);
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor = std::make_shared<boost::asio::ip::tcp::acceptor>(io);
+    acceptor->open(endpoint.protocol());
+    acceptor->set_option(boost::asio::socket_base::reuse_address(true));
+    acceptor->bind(endpoint);
+    acceptor->listen(0);
+    // NB - never accepted, they fill the backlog
+    for (int idx = 0; idx < 4; idx++) {
+        pending.push_back(std::make_shared<boost::asio::ip::tcp::socket>(io));
+        pending.back()->async_connect(endpoint, [](const boost::system::error_code&) {});
+    }
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - startTime < std::chrono::milliseconds(100)) {
+        io.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return acceptor;
+}
+
+// seconds from begin() until the first event from a sender already connected to the host, negative if none arrives
+static double measureTimeToFirstEvent(boost::asio::io_service& io, const LemmaRef& sender, const LemmaRef& lemma) {
+    bool received = false;
+    size_t handlerId = lemma->addMessageEventHandler("Tick", [&](const std::string&, const EventValue&) {
+        received = true;
+    });
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point sendTime = startTime;
+    lemma->begin();
+    while (!received && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10)) {
+        if (std::chrono::steady_clock::now() >= sendTime) {
+            sender->sendMessage("Tick", 1);
+            sendTime += std::chrono::milliseconds(2);
+        }
+        io.poll();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    // NB - the lemma keeps hearing ticks after this returns
+    lemma->removeMessageEventHandler(handlerId);
+    return received ? elapsed : -1.0;
+}
+
+static void testTimeToFirstEvent() {
+    boost::asio::io_service io;
+    HostRef host = Host::create(io, sRoomName, sHostPort);
+    host->begin();
+
+    LemmaRef sender = Lemma::create("host_cache_sender", sRoomName, Lemma::Format().ioService(io));
+    sender->begin("127.0.0.1", sHostPort);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    while (!sender->isConnected() && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10)) {
+        io.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    NOAM_CHECK(sender->isConnected());
+
+    ci::fs::path cachePath = ci::fs::temp_directory_path() / ci::fs::unique_path("noam_host_cache_%%%%%%%%");
+
+    // warm, the host does not answer broadcasts for the lemma's room so the cached host is all it has
+    writeHostCache(cachePath, sHostPort);
+    LemmaRef warm = Lemma::create("host_cache_warm", "not_answered", Lemma::Format().ioService(io).hostCachePath(cachePath));
+    double warmTime = measureTimeToFirstEvent(io, sender, warm);
+    NOAM_CHECK(warmTime >= 0.0 && warmTime < 0.5);
+    NOAM_CHECK(warm->getDiscoveryStats().discoveries == 0);
+
+    // stale, the cached host is gone and discovery finds the host where it is now, which is cached from then on
+    writeHostCache(cachePath, sStaleHostPort);
+    LemmaRef stale = Lemma::create("host_cache_stale", sRoomName, Lemma::Format().ioService(io).hostCachePath(cachePath));
+    double staleTime = measureTimeToFirstEvent(io, sender, stale);
+    NOAM_CHECK(staleTime >= 0.0);
+    NOAM_CHECK(stale->getDiscoveryStats().discoveries > 0);
+    NOAM_CHECK(readHostCachePort(cachePath) == sHostPort);
+
+    // unresponsive, the attempt on the cached host hangs and the host discovery finds meanwhile takes over from it
+    std::vector<TcpSocketRef> pending;
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> listener = createUnresponsiveListener(io, pending);
+    writeHostCache(cachePath, sUnresponsiveHostPort);
+    LemmaRef unresponsive = Lemma::create("host_cache_unresponsive", sRoomName, Lemma::Format().ioService(io).hostCachePath(cachePath));
+    double unresponsiveTime = measureTimeToFirstEvent(io, sender, unresponsive);
+    NOAM_CHECK(unresponsiveTime >= 0.0 && unresponsiveTime < 1.0);
+    NOAM_CHECK(unresponsive->getDiscoveryStats().discoveries > 0);
+    NOAM_CHECK(readHostCachePort(cachePath) == sHostPort);
+
+    std::printf("time to first event  warm cache %6.1f ms  stale cache %6.1f ms  unresponsive cache %6.1f ms\n", warmTime * 1.0e3, staleTime * 1.0e3, unresponsiveTime * 1.0e3);
+
+    ci::fs::remove(cachePath);
+}
+
+int main(int argc, const char* argv[]) {
+    testTimeToFirstEvent();
+    return Check::finish("HostCacheTest");
+}
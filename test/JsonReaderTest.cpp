@@ -0,0 +1,191 @@
+//
+//  JsonReaderTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "FrameEncoder.h"
+#include "JsonReader.h"
+#include "JsonScanner.h"
+#include <clocale>
+#include <limits>
+#include <random>
+
+using namespace Cinder::Noam;
+
+// the string a JSON string literal reads as, "<error>" when it does not read
+static std::string readString(const std::string& json) {
+    JsonReader reader;
+    reader.reset(json);
+    boost::string_ref value;
+    if (!reader.readString(value)) {
+        return "<error>";
+    }
+    return std::string(value.data(), value.size());
+}
+
+// byte at a time and structured differently from JsonScanner's, the code point is decoded in full and then range checked
+static bool isValidUTF8(const std::string& data) {
+    size_t idx = 0;
+    while (idx < data.size()) {
+        unsigned char c = static_cast<unsigned char>(data[idx]);
+        size_t length = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || idx + length > data.size()) {
+            return false;
+        }
+        uint32_t codePoint = length == 1 ? c : c & (0x7F >> length);
+        for (size_t offset = 1; offset < length; offset++) {
+            unsigned char continuation = static_cast<unsigned char>(data[idx + offset]);
+            if ((continuation & 0xC0) != 0x80) {
+                return false;
+            }
+            codePoint = (codePoint << 6) | (continuation & 0x3F);
+        }
+        const uint32_t minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (codePoint < minimum[length] || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return false;
+        }
+        idx += length;
+    }
+    return true;
+}
+
+static size_t findSpecial(const std::string& data, size_t offset) {
+    for (size_t idx = offset; idx < data.size(); idx++) {
+        unsigned char c = static_cast<unsigned char>(data[idx]);
+        if (c < 0x20 || c == '"' || c == '\\') {
+            return idx - offset;
+        }
+    }
+    return data.size() - offset;
+}
+
+// plain ASCII runs long enough for whole vectors, with well formed, ill formed and special pieces in between
+static std::string makeText(std::mt19937& random, size_t pieces, bool wellFormed) {
+    const std::vector<std::string> valid = {"a", "Jean-Pierre ", std::string(40, 'x'), "caf\xC3\xA9", "\xE2\x80\x94", "\xEF\xBF\xBD", "\xF0\x9F\x8E\xB9", "\xF4\x8F\xBF\xBF", "\xED\x9F\xBF", "\"", "\\", "\n", "\t", std::string(1, '\0'), "\x1F", "\x7F"};
+    const std::vector<std::string> invalid = {"\x80", "\xC0\x80", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xE2\x82", "\xF0\x9F\x8E", "\xC3"};
+    std::uniform_int_distribution<size_t> validDistribution(0, valid.size() - 1);
+    std::uniform_int_distribution<size_t> invalidDistribution(0, invalid.size() - 1);
+
+    std::string text;
+    for (size_t idx = 0; idx < pieces; idx++) {
+        text += valid[validDistribution(random)];
+    }
+    if (!wellFormed) {
+        std::uniform_int_distribution<size_t> offsetDistribution(0, text.size());
+        text.insert(offsetDistribution(random), invalid[invalidDistribution(random)]);
+    }
+    return text;
+}
+
+static void testSurrogates() {
+    NOAM_CHECK(readString("\"\\u00e9\\u2014\"") == "\xC3\xA9\xE2\x80\x94");
+    NOAM_CHECK(readString("\"\\ud83c\\udfb9\"") == "\xF0\x9F\x8E\xB9");
+    NOAM_CHECK(readString("\"\\uDBFF\\uDFFF\"") == "\xF4\x8F\xBF\xBF");
+
+    // unpaired halves become U+FFFD, whatever follows them
+    NOAM_CHECK(readString("\"\\ud800\"") == "\xEF\xBF\xBD");
+    NOAM_CHECK(readString("\"\\udc00\"") == "\xEF\xBF\xBD");
+    NOAM_CHECK(readString("\"a\\ud800b\"") == "a\xEF\xBF\xBD" "b");
+    NOAM_CHECK(readString("\"\\ud800\\n\"") == "\xEF\xBF\xBD\n");
+    NOAM_CHECK(readString("\"\\ud800\\u0041\"") == "\xEF\xBF\xBD" "A");
+    NOAM_CHECK(readString("\"\\ud800\\ud800\\udc00\"") == "\xEF\xBF\xBD\xF0\x90\x80\x80");
+    NOAM_CHECK(readString("\"\\udc00\\ud800\"") == "\xEF\xBF\xBD\xEF\xBF\xBD");
+    NOAM_CHECK(readString("\"\\ud800\\u12\"") == "<error>");
+
+    // whatever the escapes, what is read is well formed
+    std::mt19937 random(1030);
+    const std::vector<std::string> escapes = {"\\ud800", "\\udbff", "\\udc00", "\\udfff", "\\ud83c\\udfb9", "\\u0041", "\\n", "x", "\xC3\xA9"};
+    std::uniform_int_distribution<size_t> escapeDistribution(0, escapes.size() - 1);
+    for (int round = 0; round < 10000; round++) {
+        std::string json = "\"";
+        for (int idx = 0; idx < 1 + round % 8; idx++) {
+            json += escapes[escapeDistribution(random)];
+        }
+        json += "\"";
+        std::string value = readString(json);
+        NOAM_CHECK(value != "<error>" && isValidUTF8(value));
+    }
+}
+
+static void testInvalidUTF8() {
+    NOAM_CHECK(readString("\"\xED\xA0\x80\"") == "<error>");
+    NOAM_CHECK(readString("\"\\n\xC0\x80\"") == "<error>");
+    NOAM_CHECK(readString("\"" + std::string(40, 'x') + "\xF4\x90\x80\x80\"") == "<error>");
+}
+
+static void testScanner() {
+    std::mt19937 random(1030);
+    for (int round = 0; round < 20000; round++) {
+        std::string text = makeText(random, 1 + round % 24, round % 3 != 0);
+
+        // every offset, so the vector loops start at every alignment and hand over to the scalar tail at every length
+        for (size_t offset = 0; offset < text.size(); offset += 1 + round % 5) {
+            NOAM_CHECK(JsonScanner::findSpecial(text.data() + offset, text.size() - offset) == findSpecial(text, offset));
+        }
+        NOAM_CHECK(JsonScanner::isValidUTF8(text.data(), text.size()) == isValidUTF8(text));
+    }
+
+    const std::string plain(100, 'a');
+    for (size_t size = 0; size <= plain.size(); size++) {
+        NOAM_CHECK(JsonScanner::findSpecial(plain.data(), size) == size);
+        NOAM_CHECK(JsonScanner::isValidUTF8(plain.data(), size));
+    }
+}
+
+static void testEscaper() {
+    // what the encoder escapes the reader reads back as it was, plain runs of every length in between
+    std::mt19937 random(1030);
+    FrameEncoder encoder;
+    for (int round = 0; round < 20000; round++) {
+        std::string text = makeText(random, 1 + round % 24, true);
+        encoder.clear();
+        encoder.appendString(text);
+        std::string json(encoder.getData(), encoder.getSize());
+
+        bool hasControl = false;
+        for (char c : json) {
+            hasControl |= static_cast<unsigned char>(c) < 0x20;
+        }
+        NOAM_CHECK(!hasControl);
+        NOAM_CHECK(readString(json) == text);
+    }
+}
+
+// the number a JSON number reads as, NaN when it does not read
+static double readNumber(const std::string& json) {
+    JsonReader reader;
+    reader.reset(json);
+    EventValue value;
+    if (!reader.readValue(value)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return value.asDouble();
+}
+
+static void testLocale() {
+    // NB - skipped where no locale with a decimal comma is installed
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE", "fr_FR"};
+    for (const char* locale : locales) {
+        if (std::setlocale(LC_NUMERIC, locale)) {
+            NOAM_CHECK(readNumber("0.5") == 0.5);
+            NOAM_CHECK(readNumber("-1.25e2") == -125.0);
+            // longer than the stack buffer
+            NOAM_CHECK(readNumber("0." + std::string(80, '0') + "1e81") == 1.0);
+            std::setlocale(LC_NUMERIC, "C");
+            return;
+        }
+    }
+}
+
+int main(int argc, const char* argv[]) {
+    testSurrogates();
+    testInvalidUTF8();
+    testScanner();
+    testEscaper();
+    testLocale();
+    return Check::finish("JsonReaderTest");
+}
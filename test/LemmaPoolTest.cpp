@@ -0,0 +1,56 @@
+//
+//  LemmaPoolTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "Host.h"
+#include "LemmaPool.h"
+#include <thread>
+
+using namespace Cinder::Noam;
+
+static const uint16_t sHostPort = 7748;
+static const char* sRoomName = "lemma_pool_test";
+
+// a lemma joining once the cycle's answer has been handed out, before any lemma is connected, is given the host all
+//  the same rather than waiting for a broadcast that is not coming
+static void testLateJoin() {
+    boost::asio::io_service io;
+    HostRef host = Host::create(io, sRoomName, sHostPort);
+    host->begin();
+
+    // NB - a single broadcast per cycle, the one answer is all there is
+    LemmaPoolRef pool = LemmaPool::create(sRoomName, LemmaPool::Format().ioService(io).discoverySchedule(DiscoverySchedule::Format().burst({}).initialInterval(60 * 1000)));
+    LemmaRef first = pool->createLemma("lemma_pool_first");
+    pool->begin();
+
+    // handler by handler, so the answer is read while the first lemma is yet to connect to the host
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    while (pool->getDiscoveryStats().discoveries == 0 && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10)) {
+        if (!io.poll_one()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    NOAM_CHECK(pool->getDiscoveryStats().discoveries == 1);
+    NOAM_CHECK(!first->isConnected());
+
+    LemmaRef late = pool->createLemma("lemma_pool_late");
+    late->begin();
+    startTime = std::chrono::steady_clock::now();
+    while (pool->getConnectedCount() < 2 && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10)) {
+        io.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    NOAM_CHECK(first->isConnected());
+    NOAM_CHECK(late->isConnected());
+    NOAM_CHECK(pool->getDiscoveryStats().broadcasts == 1);
+}
+
+int main(int argc, const char* argv[]) {
+    testLateJoin();
+    return Check::finish("LemmaPoolTest");
+}
@@ -0,0 +1,98 @@
+//
+//  SendBufferTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "SendBuffer.h"
+#include "SymbolTable.h"
+
+using namespace Cinder::Noam;
+
+// NB - a one letter name and 7 bytes of data take 40 with the record ahead of them
+static const size_t sRecordSize = 40;
+
+static bool push(const SendBufferRef& buffer, const std::string& eventName, bool conflated, const std::string& data) {
+    return buffer->push(eventName, conflated, 0, 0, data.data(), data.size());
+}
+
+static std::vector<std::string> drain(const SendBufferRef& buffer) {
+    std::vector<std::string> entries;
+    buffer->drain([&](const char* data, size_t size) {
+        entries.push_back(std::string(data, size));
+    });
+    return entries;
+}
+
+static void testConflation() {
+    SendBufferRef buffer = SendBuffer::create(SendBuffer::Format().capacity(3 * sRecordSize));
+    NOAM_CHECK(push(buffer, "a", true, "first.."));
+    NOAM_CHECK(push(buffer, "b", false, "other.."));
+    NOAM_CHECK(push(buffer, "a", true, "second."));
+    NOAM_CHECK(buffer->getCount() == 2);
+    NOAM_CHECK(buffer->getStats().conflated == 1);
+
+    // full, the entry replaced makes the room
+    NOAM_CHECK(push(buffer, "c", false, "third.."));
+    NOAM_CHECK(push(buffer, "a", true, "latest."));
+    NOAM_CHECK(buffer->getStats().dropped == 0);
+    NOAM_CHECK(drain(buffer) == std::vector<std::string>({"other..", "third..", "latest."}));
+}
+
+// once full a newer value that does not fit is dropped and the buffered one kept, not both lost
+static void testDropNewest() {
+    SendBufferRef buffer = SendBuffer::create(SendBuffer::Format().capacity(3 * sRecordSize).overflow(SendBuffer::Overflow::DropNewest));
+    NOAM_CHECK(push(buffer, "b", false, "other.."));
+    NOAM_CHECK(push(buffer, "c", false, "third.."));
+    NOAM_CHECK(push(buffer, "a", true, "older.."));
+    NOAM_CHECK(!push(buffer, "a", true, "longer than the older one"));
+    NOAM_CHECK(buffer->getStats().dropped == 1);
+    NOAM_CHECK(buffer->getStats().conflated == 0);
+    NOAM_CHECK(buffer->getCount() == 3);
+
+    // the same size fits in place of it
+    NOAM_CHECK(push(buffer, "a", true, "newer.."));
+    NOAM_CHECK(buffer->getStats().conflated == 1);
+    NOAM_CHECK(drain(buffer) == std::vector<std::string>({"other..", "third..", "newer.."}));
+}
+
+// events whose names hash the same are still told apart
+static void testHashCollision() {
+    NOAM_CHECK(SymbolTable::hash("Event313708") == SymbolTable::hash("Event1063792"));
+
+    SendBufferRef buffer = SendBuffer::create();
+    NOAM_CHECK(push(buffer, "Event313708", true, "first"));
+    NOAM_CHECK(push(buffer, "Event1063792", true, "other"));
+    NOAM_CHECK(push(buffer, "Event313708", true, "second"));
+    NOAM_CHECK(buffer->getStats().conflated == 1);
+    NOAM_CHECK(drain(buffer) == std::vector<std::string>({"other", "second"}));
+}
+
+// what was buffered in a file is there again when it is next opened, names and all
+static void testRestore() {
+    fs::path path = fs::temp_directory_path() / fs::unique_path("noam_send_buffer_%%%%%%%%");
+    {
+        SendBufferRef buffer = SendBuffer::create(SendBuffer::Format().path(path));
+        NOAM_CHECK(buffer->isPersistent());
+        NOAM_CHECK(push(buffer, "a", true, "first.."));
+        NOAM_CHECK(push(buffer, "b", false, "other.."));
+    }
+    SendBufferRef buffer = SendBuffer::create(SendBuffer::Format().path(path));
+    NOAM_CHECK(buffer->getStats().restored == 2);
+    NOAM_CHECK(push(buffer, "a", true, "second."));
+    NOAM_CHECK(buffer->getStats().conflated == 1);
+    NOAM_CHECK(drain(buffer) == std::vector<std::string>({"other..", "second."}));
+    buffer = nullptr;
+    fs::remove(path);
+}
+
+int main(int argc, const char* argv[]) {
+    testConflation();
+    testDropNewest();
+    testHashCollision();
+    testRestore();
+    return Check::finish("SendBufferTest");
+}
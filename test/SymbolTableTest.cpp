@@ -0,0 +1,101 @@
+//
+//  SymbolTableTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "SymbolTable.h"
+#include <random>
+#include <thread>
+
+using namespace Cinder::Noam;
+
+static const Symbol sNameCount = 50 * 1000;
+
+static std::string makeName(Symbol symbol) {
+    return "Event" + std::to_string(symbol);
+}
+
+static void testIntern() {
+    SymbolTable table;
+    NOAM_CHECK(table.size() == 0);
+    NOAM_CHECK(table.find("Event0") == sInvalidSymbol);
+
+    for (Symbol symbol = 0; symbol < 1000; symbol++) {
+        NOAM_CHECK(table.intern(makeName(symbol)) == symbol);
+    }
+    NOAM_CHECK(table.size() == 1000);
+    NOAM_CHECK(table.intern("Event42") == 42);
+    NOAM_CHECK(table.size() == 1000);
+    for (Symbol symbol = 0; symbol < 1000; symbol++) {
+        NOAM_CHECK(table.find(makeName(symbol)) == symbol);
+        NOAM_CHECK(table.getName(symbol) == makeName(symbol));
+    }
+    // NB - straight out of a frame, not terminated where the name ends
+    std::string frame = "[\"event\",\"guest\",\"Event7\",1]";
+    NOAM_CHECK(table.find(boost::string_ref(frame.data() + 18, 6)) == 7);
+    NOAM_CHECK(table.find("Event1000") == sInvalidSymbol);
+    NOAM_CHECK(table.find("") == sInvalidSymbol);
+
+    // copies keep the symbols and then go their own way
+    SymbolTable copy(table);
+    NOAM_CHECK(copy.size() == 1000 && copy.find("Event999") == 999);
+    NOAM_CHECK(copy.intern("Copied") == 1000);
+    NOAM_CHECK(table.find("Copied") == sInvalidSymbol);
+}
+
+// readers resolve names on other threads while the table grows, each symbol they see is whole
+static void testConcurrentLookups() {
+    SymbolTable table;
+    std::atomic<bool> interning(true);
+    std::atomic<size_t> failures(0);
+    std::atomic<size_t> lookups(0);
+
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 3; reader++) {
+        readers.push_back(std::thread([&, reader]() {
+            std::mt19937 random(reader);
+            size_t count = 0;
+            while (interning) {
+                size_t size = table.size();
+                if (size == 0) {
+                    continue;
+                }
+                Symbol symbol = static_cast<Symbol>(random() % size);
+                if (table.find(makeName(symbol)) != symbol || table.getName(symbol) != makeName(symbol)) {
+                    failures++;
+                }
+                // NB - not yet interned, or never will be
+                Symbol unseen = table.find(makeName(sNameCount + static_cast<Symbol>(random() % 1000)));
+                if (unseen != sInvalidSymbol) {
+                    failures++;
+                }
+                count++;
+            }
+            lookups += count;
+        }));
+    }
+
+    for (Symbol symbol = 0; symbol < sNameCount; symbol++) {
+        if (table.intern(makeName(symbol)) != symbol) {
+            failures++;
+        }
+    }
+    interning = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    NOAM_CHECK(failures == 0);
+    NOAM_CHECK(lookups > 0);
+    NOAM_CHECK(table.size() == sNameCount);
+}
+
+int main(int argc, const char* argv[]) {
+    testIntern();
+    testConcurrentLookups();
+    return Check::finish("SymbolTableTest");
+}
@@ -0,0 +1,86 @@
+//
+//  WriteQueueTest.cpp
+//  Cinder-NoamProtocol
+//
+//  Created by agent on 17 Oct 2026.
+//  Copyright 2026 Chorded Constructions. All rights reserved.
+//
+
+#include "Check.h"
+#include "FrameReader.h"
+#include "WriteQueue.h"
+#include <thread>
+
+using namespace Cinder::Noam;
+
+static const int64_t sFrames = 20 * 1000;
+
+static void commitFrame(const WriteQueueRef& queue, int64_t value) {
+    std::lock_guard<std::mutex> lock(queue->getMutex());
+    FrameEncoder& encoder = queue->getEncoder();
+    encoder.beginFrame();
+    encoder.appendRaw("[\"event\",\"guest\",\"Count\",", 25);
+    encoder.appendValue(value);
+    encoder.appendRaw(']');
+    encoder.endFrame();
+    queue->commit();
+}
+
+// each write completing commits the next frame from its handler, as a lemma tracing its writes would send, while another
+//  thread watches the queue through snapshots
+static void testCommitFromHandler() {
+    boost::asio::io_service io;
+    boost::asio::ip::tcp::acceptor acceptor(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    TcpSocketRef client = std::make_shared<boost::asio::ip::tcp::socket>(io);
+    TcpSocketRef server = std::make_shared<boost::asio::ip::tcp::socket>(io);
+    client->connect(acceptor.local_endpoint());
+    acceptor.accept(*server);
+
+    WriteQueueRef queue = WriteQueue::create(io);
+    FrameReaderRef reader = FrameReader::create();
+    int64_t sent = 0;
+    int64_t received = 0;
+    queue->connectWriteEventHandler([&](size_t) {
+        if (sent < sFrames) {
+            commitFrame(queue, sent++);
+        }
+    });
+    reader->connectFrameEventHandler([&](const boost::string_ref&) {
+        received++;
+    });
+    queue->open(client);
+    reader->open(server);
+
+    std::atomic<bool> writing(true);
+    bool consistent = true;
+    std::thread watcher([&]() {
+        uint64_t frames = 0;
+        while (writing) {
+            WriteQueue::Snapshot snapshot = queue->getSnapshot();
+            consistent &= snapshot.stats.frames >= frames && snapshot.stats.frames <= static_cast<uint64_t>(sFrames);
+            frames = snapshot.stats.frames;
+        }
+    });
+
+    commitFrame(queue, sent++);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    while (received < sFrames && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(30)) {
+        io.run_one();
+    }
+    writing = false;
+    watcher.join();
+
+    WriteQueue::Snapshot snapshot = queue->getSnapshot();
+    NOAM_CHECK(received == sFrames);
+    NOAM_CHECK(consistent);
+    NOAM_CHECK(snapshot.stats.frames == static_cast<uint64_t>(sFrames));
+    NOAM_CHECK(snapshot.pendingFrameCount == 0 && snapshot.queuedByteCount == 0);
+
+    reader->close();
+    queue->close();
+}
+
+int main(int argc, const char* argv[]) {
+    testCommitFromHandler();
+    return Check::finish("WriteQueueTest");
+}
@@ -33,22 +33,22 @@ void LemmaVerificationApp::setup() {
     mLemma = Lemma::create("cinder-noamprotocol_verification", "lemma_verification");
 
     // https://github.com/noam-io/host/blob/master/lemma_verification/tests/echo.rb
-    mLemma->connectMessageEventHandler("Echo", [&](const std::string& eventName, const std::string& eventValue) {
+    mLemma->connectMessageEventHandler("Echo", [&](const std::string& eventName, const EventValue& eventValue) {
         mLemma->sendMessage("EchoVerify", eventValue);
     });
 
     // https://github.com/noam-io/host/blob/master/lemma_verification/tests/plus_one.rb
-    mLemma->connectMessageEventHandler("PlusOne", [&](const std::string& eventName, const std::string& eventValue) {
+    mLemma->connectMessageEventHandler("PlusOne", [&](const std::string& eventName, const EventValue& eventValue) {
         // NB - integer inputs
-        int value = fromString<int>(eventValue) + 1;
+        int value = static_cast<int>(eventValue.asInt()) + 1;
         mLemma->sendMessage("PlusOneVerify", value);
     });
 
     // https://github.com/noam-io/host/blob/master/lemma_verification/tests/sum.rb
-    mLemma->connectMessageEventHandler("Sum", [&](const std::string& eventName, const std::string& eventValue) {
+    mLemma->connectMessageEventHandler("Sum", [&](const std::string& eventName, const EventValue& eventValue) {
         // NB - integer inputs
         int value = 0;
-        JsonTree array = JsonTree(eventValue);
+        const JsonTree& array = eventValue.asJsonTree();
         for (JsonTree::ConstIter it = array.begin(); it != array.end(); ++it) {
             value += (*it).getValue<int>();
         }
@@ -56,8 +56,8 @@ void LemmaVerificationApp::setup() {
     });
 
     // https://github.com/noam-io/host/blob/master/lemma_verification/tests/name.rb
-    mLemma->connectMessageEventHandler("Name", [&](const std::string& eventName, const std::string& eventValue) {
-        JsonTree object = JsonTree(eventValue);
+    mLemma->connectMessageEventHandler("Name", [&](const std::string& eventName, const EventValue& eventValue) {
+        const JsonTree& object = eventValue.asJsonTree();
         string name = str(boost::format("%1% %2%") % object.getValueForKey("firstName") % object.getValueForKey("lastName"));
         JsonTree value = JsonTree::makeObject();
         value.addChild(JsonTree("fullName", name));